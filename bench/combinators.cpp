@@ -0,0 +1,241 @@
+// Compares fu's combinators against the hand-written code they stand for, in
+// ns per call and, where the kernel allows reading the hardware counters,
+// instructions per cycle. Flags any combinator over 5% slower than its
+// baseline.
+
+#include <fu/fu.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/// Counts cycles and instructions of this thread, if the kernel allows it.
+class Counters {
+  int cycles = -1;
+  int insts = -1;
+
+#ifdef __linux__
+  static int open(std::uint64_t config, int group) {
+    perf_event_attr attr{};
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof attr;
+    attr.config = config;
+    attr.disabled = group < 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return syscall(__NR_perf_event_open, &attr, 0, -1, group, 0);
+  }
+
+public:
+  Counters() {
+    cycles = open(PERF_COUNT_HW_CPU_CYCLES, -1);
+    if (cycles >= 0) insts = open(PERF_COUNT_HW_INSTRUCTIONS, cycles);
+  }
+
+  ~Counters() {
+    if (insts >= 0) close(insts);
+    if (cycles >= 0) close(cycles);
+  }
+
+  bool ok() const { return insts >= 0; }
+
+  void start() {
+    if (!ok()) return;
+    ioctl(cycles, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(cycles, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+
+  /// Instructions per cycle since start().
+  double stop() {
+    if (!ok()) return 0;
+    ioctl(cycles, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    long long c = 0, i = 0;
+    if (read(cycles, &c, sizeof c) != sizeof c ||
+        read(insts, &i, sizeof i) != sizeof i || c == 0)
+      return 0;
+    return double(i) / c;
+  }
+#else
+public:
+  bool ok() const { return false; }
+  void start() { }
+  double stop() { return 0; }
+#endif
+};
+
+struct P {
+  int x, y;
+};
+
+/// Sums op(ps[i], ps[i+1]) over the points. Not inlined, so that each
+/// kernel is compiled, and timed, on its own.
+template<class Op>
+__attribute__((noinline)) long run(const Op& op, const std::vector<P>& ps) {
+  long s = 0;
+  for (std::size_t i = 0; i + 1 < ps.size(); i++) s += op(ps[i], ps[i+1]);
+  return s;
+}
+
+struct Sample {
+  double ns;
+  double ipc;
+};
+
+Counters counters;
+std::vector<P> points;
+int slower = 0;
+
+/// One trial: the time, in ns per call of `op`, and IPC.
+template<class Op>
+Sample trial(const Op& op, long& result) {
+  const int reps = 200;
+
+  counters.start();
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < reps; r++) {
+    // Hide that `points` does not change, so each call is made.
+    asm volatile("" : : : "memory");
+    result = run(op, points);
+  }
+  std::chrono::duration<double, std::nano> d =
+    std::chrono::steady_clock::now() - start;
+  double ipc = counters.stop();
+
+  return Sample{d.count() / reps / (points.size() - 1), ipc};
+}
+
+/// Takes the fastest of several trials of each, alternating between them so
+/// that both see the same changes in clock speed and load.
+template<class Base, class Fu>
+void bench(const char* name, const Base& base, const Fu& fu) {
+  const int trials = 15;
+
+  long expect = run(base, points);  // Warm up.
+  long got = run(fu, points);
+
+  Sample b{1e300, 0}, f{1e300, 0};
+  for (int t = 0; t < trials; t++) {
+    Sample s = trial(base, expect);
+    if (s.ns < b.ns) b = s;
+    s = trial(fu, got);
+    if (s.ns < f.ns) f = s;
+  }
+
+  bool slow = f.ns > 1.05 * b.ns;
+  slower += slow;
+  if (counters.ok()) {
+    std::printf("%-16s %8.3f %8.3f %6.2f %6.2f %8.2fx%s%s\n", name, b.ns, f.ns,
+                b.ipc, f.ipc, b.ns / f.ns, slow ? "  SLOWER" : "",
+                got != expect ? "  WRONG" : "");
+  } else {
+    std::printf("%-16s %8.3f %8.3f %6s %6s %8.2fx%s%s\n", name, b.ns, f.ns,
+                "-", "-", b.ns / f.ns, slow ? "  SLOWER" : "",
+                got != expect ? "  WRONG" : "");
+  }
+}
+
+int main() {
+  std::mt19937 gen(1);
+  std::uniform_int_distribution<int> dist(-1000, 1000);
+  points.resize(1 << 12);
+  for (P& p : points) p = P{dist(gen), dist(gen)};
+
+  std::printf("%-16s %8s %8s %6s %6s %9s\n", "(ns/call)", "manual", "fu",
+              "ipc", "ipc", "speedup");
+
+  // functional.h and utility.h
+  bench("add(1)",
+        [](const P& a, const P&) { return a.x + 1; },
+        [](const P& a, const P&) { return fu::add(1)(a.x); });
+  bench("pipe",
+        [](const P& a, const P&) { return (a.x + 1) * 2; },
+        [](const P& a, const P&) {
+          return fu::pipe(a.x, fu::add(1), fu::mult(2));
+        });
+  bench("ucompose",
+        [](const P& a, const P&) { return (a.x + 1) * 2; },
+        [f = fu::ucompose(fu::mult(2), fu::add(1))](const P& a, const P&) {
+          return f(a.x);
+        });
+  bench("mcompose",
+        [](const P& a, const P&) { return (a.x + a.y) * 2; },
+        [f = fu::mcompose(fu::mult(2), fu::add)](const P& a, const P&) {
+          return f(a.x, a.y);
+        });
+  bench("compose_n<2>",
+        [](const P& a, const P& b) { return (a.x + a.y) * b.x; },
+        [f = fu::compose_n<2>(fu::mult, fu::add)](const P& a, const P& b) {
+          return f(a.x, a.y, b.x);
+        });
+  bench("flip",
+        [](const P& a, const P& b) { return b.x - a.x; },
+        [f = fu::flip(fu::sub)](const P& a, const P& b) { return f(a.x, b.x); });
+  bench("proj",
+        [](const P& a, const P& b) { return a.y + b.y; },
+        [f = fu::proj(fu::add, &P::y)](const P& a, const P& b) {
+          return f(a, b);
+        });
+  bench("proj_less",
+        [](const P& a, const P& b) { return a.x < b.x; },
+        [f = fu::proj_less(&P::x)](const P& a, const P& b) { return f(a, b); });
+  bench("max",
+        [](const P& a, const P& b) { return std::max({a.x, a.y, b.x}); },
+        [](const P& a, const P& b) { return fu::max(a.x, a.y, b.x); });
+  bench("add x6 (double)",
+        [](const P& a, const P& b) {
+          double p = a.x, q = a.y, r = b.x, s = b.y;
+          return p*q + p*r + p*s + q*r + q*s + r*s;
+        },
+        [](const P& a, const P& b) {
+          double p = a.x, q = a.y, r = b.x, s = b.y;
+          return fu::add(p*q, p*r, p*s, q*r, q*s, r*s);
+        });
+  bench("min",
+        [](const P& a, const P& b) { return std::min({a.x, a.y, b.x}); },
+        [](const P& a, const P& b) { return fu::min(a.x, a.y, b.x); });
+
+  // tuple/tuple.h
+  bench("tpl::foldl",
+        [](const P& a, const P& b) { return a.x + a.y + b.x + b.y; },
+        [](const P& a, const P& b) {
+          return fu::tpl::foldl(fu::add, 0, std::tie(a.x, a.y, b.x, b.y));
+        });
+  bench("tpl::map",
+        [](const P& a, const P&) { return (a.x + 1) * (a.y + 1); },
+        [](const P& a, const P&) {
+          auto t = fu::tpl::map(fu::add(1), std::tie(a.x, a.y));
+          return std::get<0>(t) * std::get<1>(t);
+        });
+  bench("tpl::apply",
+        [](const P& a, const P& b) { return a.x * b.y; },
+        [](const P& a, const P& b) {
+          return fu::tpl::apply(fu::mult, std::tie(a.x, b.y));
+        });
+
+  // logic/logic.h
+  auto pos = [](int x) { return x > 0; };
+  bench("logic::all",
+        [=](const P& a, const P& b) { return pos(a.x) && pos(a.y) && pos(b.x); },
+        [f = fu::logic::all(pos)](const P& a, const P& b) {
+          return f(a.x, a.y, b.x);
+        });
+  bench("logic::any",
+        [=](const P& a, const P& b) { return pos(a.x) || pos(a.y) || pos(b.x); },
+        [f = fu::logic::any(pos)](const P& a, const P& b) {
+          return f(a.x, a.y, b.x);
+        });
+
+  if (slower)
+    std::printf("%d combinator(s) over 5%% slower than manual code\n", slower);
+}
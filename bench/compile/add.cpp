@@ -0,0 +1,16 @@
+// fu::add applied to BENCH_N arguments at once.
+
+#include <fu/fu.h>
+
+#ifndef BENCH_N
+#define BENCH_N 64
+#endif
+
+template<std::size_t...i>
+int sum(std::index_sequence<i...>) {
+  return fu::add(int(i)...);
+}
+
+int main() {
+  return sum(std::make_index_sequence<BENCH_N>{}) != BENCH_N * (BENCH_N-1) / 2;
+}
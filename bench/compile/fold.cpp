@@ -0,0 +1,21 @@
+// fu::sub, fu::rassoc(fu::sub) and logic::all applied to BENCH_N arguments,
+// folded one by one rather than as a tree.
+
+#include <fu/fu.h>
+
+#ifndef BENCH_N
+#define BENCH_N 64
+#endif
+
+template<std::size_t...i>
+int fold(std::index_sequence<i...>) {
+  auto nonneg = [](int x) { return x >= 0; };
+  int l = fu::sub(int(i)...);
+  int r = fu::rassoc(fu::sub, int(i)...);
+  bool all = fu::logic::all(nonneg)(int(i)...);
+  return l + r + all;
+}
+
+int main() {
+  return fold(std::make_index_sequence<BENCH_N>{}) == 0;
+}
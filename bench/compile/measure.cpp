@@ -0,0 +1,39 @@
+// Runs a command and prints its wall time, in seconds, and the peak resident
+// set size of the process, in KiB. Exits with the command's status.
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    std::fprintf(stderr, "usage: %s command [args...]\n", argv[0]);
+    return 2;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  pid_t pid = fork();
+  if (pid == 0) {
+    execvp(argv[1], argv + 1);
+    _exit(127);
+  }
+
+  int status = 0;
+  rusage usage{};
+  if (pid < 0 || wait4(pid, &status, 0, &usage) < 0) {
+    std::perror("measure");
+    return 2;
+  }
+  std::chrono::duration<double> d = std::chrono::steady_clock::now() - start;
+
+  long rss = usage.ru_maxrss;
+#ifdef __APPLE__
+  rss /= 1024;  // Bytes, not KiB.
+#endif
+
+  std::printf("%.3f %ld\n", d.count(), rss);
+  return WIFEXITED(status) ? WEXITSTATUS(status) : 1;
+}
@@ -0,0 +1,30 @@
+// A multary_n<BENCH_N> function applied to BENCH_N+1 arguments one at a time, nesting BENCH_N
+// partial applications.
+
+#include <fu/fu.h>
+
+#ifndef BENCH_N
+#define BENCH_N 16
+#endif
+
+constexpr struct sum_f {
+  template<class...X>
+  constexpr int operator() (X...x) const {
+    return fu::add(0, x...);
+  }
+} sum{};
+
+template<class F>
+constexpr int apply(std::index_sequence<>, const F& f) {
+  return f;
+}
+
+template<std::size_t i, std::size_t...is, class F>
+constexpr int apply(std::index_sequence<i, is...>, const F& f) {
+  return apply(std::index_sequence<is...>{}, f(int(i)));
+}
+
+int main() {
+  auto f = fu::multary_n<BENCH_N>(sum);
+  return apply(std::make_index_sequence<BENCH_N+1>{}, f) != BENCH_N * (BENCH_N+1) / 2;
+}
@@ -0,0 +1,28 @@
+// fu::overload of BENCH_N lambdas, each called once.
+
+#include <fu/fu.h>
+
+#ifndef BENCH_N
+#define BENCH_N 50
+#endif
+
+template<std::size_t i>
+struct Tag { };
+
+template<std::size_t i>
+auto lambda() {
+  return [](Tag<i>) { return int(i); };
+}
+
+template<std::size_t...i>
+int sum(std::index_sequence<i...>) {
+  auto f = fu::overload(lambda<i>()...);
+  int xs[] = {f(Tag<i>{})...};
+  int s = 0;
+  for (int x : xs) s += x;
+  return s;
+}
+
+int main() {
+  return sum(std::make_index_sequence<BENCH_N>{}) != BENCH_N * (BENCH_N-1) / 2;
+}
@@ -0,0 +1,18 @@
+// tpl::map and tpl::foldl over a tuple of BENCH_N elements.
+
+#include <fu/fu.h>
+
+#ifndef BENCH_N
+#define BENCH_N 64
+#endif
+
+template<std::size_t...i>
+int sum(std::index_sequence<i...>) {
+  auto t = std::make_tuple(int(i)...);
+  auto u = fu::tpl::map(fu::add(1), t);
+  return fu::tpl::foldl(fu::add, 0, u);
+}
+
+int main() {
+  return sum(std::make_index_sequence<BENCH_N>{}) != BENCH_N * (BENCH_N+1) / 2;
+}
@@ -0,0 +1,58 @@
+// Compares the trampolined fix_tc against the natively recursive fix.
+
+#include <fu/functional.h>
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+template<class F>
+double time_ns(const F& f, int reps) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < reps; i++) f();
+  std::chrono::duration<double, std::nano> d =
+    std::chrono::steady_clock::now() - start;
+  return d.count() / reps;
+}
+
+struct Node {
+  const Node* next;
+};
+
+struct length_f {
+  template<class Rec>
+  std::size_t operator() (Rec rec, const Node* n, std::size_t len) const {
+    return n ? rec(n->next, len + 1) : len;
+  }
+};
+
+struct length_tc_f {
+  template<class Rec>
+  fu::TailCall<std::size_t(const Node*, std::size_t)>
+  operator() (Rec rec, const Node* n, std::size_t len) const {
+    if (!n) return len;
+    return rec(n->next, len + 1);
+  }
+};
+
+int main() {
+  // Shallow enough for fix not to overflow the stack.
+  const std::size_t n = 10000;
+  const int reps = 1000;
+  std::vector<Node> nodes(n);
+  for (std::size_t i = 0; i + 1 < n; i++) nodes[i].next = &nodes[i+1];
+  nodes.back().next = nullptr;
+
+  std::size_t total = 0;
+  double fix = time_ns([&] { total += fu::fix(length_f{}, &nodes[0], 0); },
+                       reps);
+  double fix_tc = time_ns([&] {
+    total += fu::fix_tc(length_tc_f{}, &nodes[0], 0);
+  }, reps);
+
+  std::printf("%-21s %10s %10s %9s\n", "(ns/level)", "fix", "fix_tc",
+              "speedup");
+  std::printf("%-21s %10.2f %10.2f %8.2fx\n", "list length",
+              fix / n, fix_tc / n, fix / fix_tc);
+  if (total != 2 * reps * n) std::printf("wrong length\n");
+}
@@ -0,0 +1,57 @@
+// Compares fu::group_by and par::group_by against aggregating into a
+// std::unordered_map.
+
+#include <fu/group.h>
+
+#include <chrono>
+#include <cstdio>
+#include <unordered_map>
+#include <vector>
+
+template<class F>
+double time_ns(const F& f, int reps) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < reps; i++) f();
+  std::chrono::duration<double, std::nano> d =
+    std::chrono::steady_clock::now() - start;
+  return d.count() / reps;
+}
+
+struct Row {
+  long key;
+  long value;
+};
+
+void bench(const char* name, std::size_t keys) {
+  const std::size_t n = 1 << 22;
+  const int reps = 10;
+  std::vector<Row> rows(n);
+  for (std::size_t i = 0; i < n; i++)
+    rows[i] = Row{long((i * 2654435761u) % keys), long(i)};
+
+  auto sum = [](long acc, const Row& r) { return acc + r.value; };
+  std::size_t groups = 0;
+
+  double map = time_ns([&] {
+    std::unordered_map<long, long> m;
+    for (auto& r : rows) m[r.key] += r.value;
+    groups += m.size();
+  }, reps);
+  double seq = time_ns([&] {
+    groups += fu::group_by(&Row::key, sum, 0l, rows).size();
+  }, reps);
+  double par = time_ns([&] {
+    groups += fu::par::group_by(&Row::key, sum, 0l, rows).size();
+  }, reps);
+
+  std::printf("%-21s %10.2f %10.2f %10.2f %8.2fx %8.2fx\n", name,
+              map / n, seq / n, par / n, map / seq, map / par);
+  if (groups == 0) std::printf("unreachable\n");
+}
+
+int main() {
+  std::printf("%-21s %10s %10s %10s %9s %9s\n", "(ns/row)", "unordered",
+              "group_by", "par", "speedup", "par");
+  bench("1k keys", 1000);
+  bench("1M keys", 1000000);
+}
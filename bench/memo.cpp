@@ -0,0 +1,58 @@
+// Compares fu::memo against a std::unordered_map behind a std::mutex.
+
+#include <fu/memo.h>
+
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+template<class F>
+double time_ns(const F& f, int threads, long calls) {
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> ts;
+  for (int t = 0; t < threads; t++) ts.emplace_back(f, t);
+  for (auto& t : ts) t.join();
+  std::chrono::duration<double, std::nano> d =
+    std::chrono::steady_clock::now() - start;
+  return d.count() / (threads * calls);
+}
+
+long work(long x) { return x * x + 1; }
+
+void bench(const char* name, int threads) {
+  const long calls = 1 << 20, keys = 4096;
+
+  std::mutex m;
+  std::unordered_map<long, long> cache;
+  double locked = time_ns([&](int t) {
+    long sum = 0;
+    for (long i = 0; i < calls; i++) {
+      long x = (i * 7919 + t) % keys;
+      std::lock_guard<std::mutex> lock(m);
+      auto it = cache.find(x);
+      if (it == cache.end()) it = cache.emplace(x, work(x)).first;
+      sum += it->second;
+    }
+    if (sum == 0) std::printf("unreachable\n");
+  }, threads, calls);
+
+  auto memo = fu::memo(work, 2 * keys);
+  double memoized = time_ns([&](int t) {
+    long sum = 0;
+    for (long i = 0; i < calls; i++) sum += memo((i * 7919 + t) % keys);
+    if (sum == 0) std::printf("unreachable\n");
+  }, threads, calls);
+
+  std::printf("%-21s %10.1f %10.1f %8.2fx\n", name, locked, memoized,
+              locked / memoized);
+}
+
+int main() {
+  std::printf("%-21s %10s %10s %9s\n", "(ns/call)", "mutex+map", "memo",
+              "speedup");
+  bench("1 thread", 1);
+  bench("4 threads", 4);
+}
@@ -0,0 +1,43 @@
+// Compares fu::scanl1's in-register scan against its generic, scalar path,
+// and par::scanl1 against both.
+
+#include <fu/par.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+
+template<class F>
+double time_ns(const F& f, int reps) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < reps; i++) f();
+  std::chrono::duration<double, std::nano> d =
+    std::chrono::steady_clock::now() - start;
+  return d.count() / reps;
+}
+
+template<class T, class F>
+void bench(const char* name, const F& f) {
+  const std::size_t n = 1 << 22;
+  const int reps = 50;
+  std::vector<T> xs(n, T(1));
+
+  double scalar = time_ns([&] {
+    fu::scan_f::inclusive(fu::Rank<0>{}, f, T(0), xs.begin(), xs.end());
+  }, reps);
+  double simd = time_ns([&] { fu::scanl1(f, xs); }, reps);
+  double par = time_ns([&] { fu::par::scanl1(f, xs); }, reps);
+
+  std::printf("%-21s %10.1f %10.1f %10.1f %8.2fx %8.2fx\n", name,
+              scalar / n * 1000, simd / n * 1000, par / n * 1000,
+              scalar / simd, scalar / par);
+}
+
+int main() {
+  std::printf("%-21s %10s %10s %10s %9s %9s\n", "(ps/element)", "scalar",
+              "simd", "par", "speedup", "par");
+  bench<std::uint32_t>("uint32 add", fu::add);
+  bench<std::uint64_t>("uint64 add", fu::add);
+  bench<std::uint32_t>("uint32 bit_or", fu::bit_or);
+}
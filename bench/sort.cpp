@@ -0,0 +1,53 @@
+// Compares fu::sort_by, which projects each element once, against std::sort
+// with proj_less, which projects twice per comparison.
+
+#include <fu/par.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+template<class F>
+double time_ns(const F& f, int reps) {
+  std::chrono::duration<double, std::nano> d{0};
+  for (int i = 0; i < reps; i++) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    d += std::chrono::steady_clock::now() - start;
+  }
+  return d.count() / reps;
+}
+
+template<class T, class PF>
+void bench(const char* name, const std::vector<T>& input, const PF& pf) {
+  const int reps = 5;
+  std::vector<T> xs;
+
+  double plain = time_ns([&] {
+    xs = input;
+    std::sort(std::begin(xs), std::end(xs), fu::proj_less(pf));
+  }, reps);
+  double by = time_ns([&] { xs = input; fu::sort_by(pf, xs); }, reps);
+  double par = time_ns([&] { xs = input; fu::par::sort_by(pf, xs); }, reps);
+
+  std::size_t n = input.size();
+  std::printf("%-21s %10.1f %10.1f %10.1f %8.2fx %8.2fx\n", name,
+              plain / n, by / n, par / n, plain / by, plain / par);
+}
+
+int main() {
+  std::printf("%-21s %10s %10s %10s %9s %9s\n", "(ns/element)", "proj_less",
+              "sort_by", "par", "speedup", "par");
+
+  const std::size_t n = 1 << 20;
+  std::vector<std::string> numbers(n);
+  for (std::size_t i = 0; i < n; i++)
+    numbers[i] = std::to_string((i * 2654435761u) % 1000000007);
+  bench("parse", numbers, [](const std::string& s) { return std::stol(s); });
+
+  std::vector<long> ints(n);
+  for (std::size_t i = 0; i < n; i++) ints[i] = (i * 2654435761u) % n;
+  bench("identity", ints, fu::identity);
+}
@@ -0,0 +1,43 @@
+
+// Compares fu::transform's vector kernels against its generic, scalar path.
+
+#include <fu/list.h>
+
+#include <chrono>
+#include <cstdio>
+#include <numeric>
+#include <vector>
+
+template<class F>
+double time_ns(const F& f, int reps) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < reps; i++) f();
+  std::chrono::duration<double, std::nano> d =
+    std::chrono::steady_clock::now() - start;
+  return d.count() / reps;
+}
+
+template<class T, class F>
+void bench(const char* name, const F& f) {
+  const std::size_t n = 1 << 16;
+  const int reps = 2000;
+  std::vector<T> xs(n);
+  std::iota(std::begin(xs), std::end(xs), T(0));
+
+  double scalar = time_ns([&] {
+    fu::transform_f::map(fu::Rank<0>{}, f, xs);
+  }, reps);
+  double simd = time_ns([&] { fu::transform(f, xs); }, reps);
+
+  std::printf("%-21s %10.1f %10.1f %8.2fx\n", name,
+              scalar / n * 1000, simd / n * 1000, scalar / simd);
+}
+
+int main() {
+  std::printf("%-21s %10s %10s %9s\n", "(ps/element)", "scalar", "simd",
+              "speedup");
+  bench<int>("int32", fu::add(5));
+  bench<long>("int64", fu::add(5l));
+  bench<float>("float", fu::mult(0.5f));
+  bench<double>("double", fu::mult(0.5));
+}
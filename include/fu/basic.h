@@ -8,6 +8,7 @@
 #include <fu/iseq.h>
 #include <fu/make/make.h>
 #include <fu/tuple/basic.h>
+#include <fu/tuple/compressed.h>
 
 /// This file includes the basic functionality used to build other modules.
 
@@ -32,12 +33,11 @@ constexpr struct identity_f {
 /// function pointers and objects.
 template<class F>
 struct forwarder_f : public F {
-  F f;
-  constexpr forwarder_f(F f) : f(std::move(f)) { }
-  
+  constexpr forwarder_f(F f) : F(std::move(f)) { }
+
   template<class...X>
   constexpr decltype(auto) operator() (X&&...x) const {
-    return f(std::forward<X>(x)...);
+    return static_cast<const F&>(*this)(std::forward<X>(x)...);
   }
 };
 
@@ -196,50 +196,87 @@ template<class F>
 using ToFunctor = decltype(forwarder(std::declval<F>()));
 
 /// Partial Application
+///
+/// Stores `f` and the bound arguments in a Compressed tuple, so a Part of
+/// stateless functions is empty.
 template<class F, class...X>
-struct Part {
-  F f;
+struct Part : private tpl::Compressed<F, X...> {
+  using Base = tpl::Compressed<F, X...>;
+  using Args = std::index_sequence_for<X...>;
+
+  constexpr Part(F f, X...x)
+    : Base(tpl::FromElems{}, std::move(f), std::forward<X>(x)...)
+  {
+  }
 
-  std::tuple<X...> t;
+  /// The i'th bound argument.
+  template<std::size_t i>
+  constexpr decltype(auto) arg() const { return Base::template get<i+1>(); }
+
+  /// P<F, X..., Y...> -- This with `y...` bound after `x...`, so that binding
+  /// more arguments does not nest one Part within another.
+  template<template<class...> class P, class...Y>
+  constexpr P<F, X..., Y...> extend(Y...y) const & {
+    return extended<P, Y...>(Args{}, static_cast<const Base&>(*this),
+                             std::forward<Y>(y)...);
+  }
 
-  constexpr Part(F f, X...x) : f(std::move(f))
-                             , t(std::forward<X>(x)...)
+  template<template<class...> class P, class...Y>
+  constexpr P<F, X..., Y...> extend(Y...y) && {
+    return extended<P, Y...>(Args{}, static_cast<Base&&>(*this),
+                             std::forward<Y>(y)...);
+  }
+
+  template<template<class...> class P, class...Y, std::size_t...i, class Self>
+  static constexpr P<F, X..., Y...> extended(std::index_sequence<i...>,
+                                             Self&& self, Y...y)
   {
+    return P<F, X..., Y...>(static_cast<Self&&>(self).template get<0>(),
+                            static_cast<Self&&>(self).template get<i+1>()...,
+                            std::forward<Y>(y)...);
   }
 
-  template<class...Y, class Tuple = std::tuple<Y...>>
-  static constexpr Tuple args(Y&&...y) {
-    return Tuple(std::forward<Y>(y)...);
+  /// f(x..., y...), forwarding each from where it is stored.
+  template<std::size_t...i, class Self, class...Y>
+  static constexpr decltype(auto) call(std::index_sequence<i...>,
+                                       Self&& self, Y&&...y)
+  {
+    return fu::invoke(static_cast<Self&&>(self).template get<0>(),
+                      static_cast<Self&&>(self).template get<i+1>()...,
+                      std::forward<Y>(y)...);
   }
 
   // NOTE: due to gcc bug, decltype(auto) may not be used to define operator()
   // because the wrong overloads will be chosen.
   // https://gcc.gnu.org/bugzilla/show_bug.cgi?id=64562
-#ifdef __clang__
-# define RESULT(F) decltype(auto)
-#else
-# define RESULT(F) std::result_of_t<F(X..., Y...)>
-#endif
+  // Instead, the result is spelled out, with f and each bound argument
+  // qualified by Q, as call() forwards them, so that references are returned
+  // where decltype(auto) would return them, on every compiler. (A const
+  // rvalue's elements are forwarded as const lvalues.)
+#define RESULT(Q) decltype(fu::invoke(std::declval<F Q>(),                  \
+                                      std::declval<X Q>()...,              \
+                                      std::declval<Y>()...))
 
   template<class...Y>
-  constexpr RESULT(const F&) operator() (Y&&...y) const & {
-    return tpl::apply(f, t, args(std::forward<Y>(y)...));
+  constexpr RESULT(const&) operator() (Y&&...y) const & {
+    return call(Args{}, static_cast<const Base&>(*this), std::forward<Y>(y)...);
   }
 
   template<class...Y>
-  constexpr RESULT(const F&&) operator() (Y&&...y) && {
-    return tpl::apply(std::move(f), std::move(t), args(std::forward<Y>(y)...));
+  constexpr RESULT(&&) operator() (Y&&...y) && {
+    return call(Args{}, static_cast<Base&&>(*this), std::forward<Y>(y)...);
   }
 
 #ifdef __clang__
   template<class...Y>
-  constexpr RESULT(F&) operator() (Y&&...y) & {
-    return tpl::apply(f, t, args(std::forward<Y>(y)...));
+  constexpr RESULT(&) operator() (Y&&...y) & {
+    return call(Args{}, static_cast<Base&>(*this), std::forward<Y>(y)...);
   }
 
   template<class...Y>
-  constexpr RESULT(const F&&) operator() (Y&&...y) const && {
-    return tpl::apply(std::move(f), std::move(t), args(std::forward<Y>(y)...));
+  constexpr RESULT(const&) operator() (Y&&...y) const && {
+    return call(Args{}, static_cast<const Base&&>(*this),
+                std::forward<Y>(y)...);
   }
 #endif
 
@@ -248,49 +285,60 @@ struct Part {
 
 /// Reversed-Partial Application
 template<class F, class...X>
-struct rpart_f {
-  F f;
+struct rpart_f : private tpl::Compressed<F, X...> {
+  using Base = tpl::Compressed<F, X...>;
+  using Args = std::index_sequence_for<X...>;
 
-  std::tuple<X...> t;
-
-  constexpr rpart_f(F f, X...x) : f(std::move(f))
-                                , t(std::forward<X>(x)...)
+  constexpr rpart_f(F f, X...x)
+    : Base(tpl::FromElems{}, std::move(f), std::forward<X>(x)...)
   {
   }
 
-  template<class...Y, class Tuple = std::tuple<Y...>>
-  static constexpr Tuple args(Y&&...y) {
-    return Tuple(std::forward<Y>(y)...);
+  /// The i'th bound argument.
+  template<std::size_t i>
+  constexpr decltype(auto) arg() const { return Base::template get<i+1>(); }
+
+  /// f(y..., x...), forwarding each from where it is stored.
+  template<std::size_t...i, class Self, class...Y>
+  static constexpr decltype(auto) call(std::index_sequence<i...>,
+                                       Self&& self, Y&&...y)
+  {
+    return fu::invoke(static_cast<Self&&>(self).template get<0>(),
+                      std::forward<Y>(y)...,
+                      static_cast<Self&&>(self).template get<i+1>()...);
   }
 
   // NOTE: due to gcc bug, decltype(auto) may not be used to define operator()
   // because the wrong overloads will be chosen.
   // https://gcc.gnu.org/bugzilla/show_bug.cgi?id=64562
-#ifdef __clang__
-# define RESULT(F) decltype(auto)
-#else
-# define RESULT(F) std::result_of_t<F(Y..., X...)>
-#endif
+  // Instead, the result is spelled out, with f and each bound argument
+  // qualified by Q, as call() forwards them, so that references are returned
+  // where decltype(auto) would return them, on every compiler. (A const
+  // rvalue's elements are forwarded as const lvalues.)
+#define RESULT(Q) decltype(fu::invoke(std::declval<F Q>(),                  \
+                                      std::declval<Y>()...,                \
+                                      std::declval<X Q>()...))
 
   template<class...Y>
-  constexpr RESULT(const F&) operator() (Y&&...y) const & {
-    return tpl::apply(f, args(std::forward<Y>(y)...), t);
+  constexpr RESULT(const&) operator() (Y&&...y) const & {
+    return call(Args{}, static_cast<const Base&>(*this), std::forward<Y>(y)...);
   }
 
   template<class...Y>
-  constexpr RESULT(const F&&) operator() (Y&&...y) && {
-    return tpl::apply(std::move(f), args(std::forward<Y>(y)...), std::move(t));
+  constexpr RESULT(&&) operator() (Y&&...y) && {
+    return call(Args{}, static_cast<Base&&>(*this), std::forward<Y>(y)...);
   }
 
 #ifdef __clang__
   template<class...Y>
-  constexpr RESULT(F&) operator() (Y&&...y) & {
-    return tpl::apply(f, args(std::forward<Y>(y)...), t);
+  constexpr RESULT(&) operator() (Y&&...y) & {
+    return call(Args{}, static_cast<Base&>(*this), std::forward<Y>(y)...);
   }
 
   template<class...Y>
-  constexpr RESULT(const F&&) operator() (Y&&...y) const && {
-    return tpl::apply(std::move(f), args(std::forward<Y>(y)...), std::move(t));
+  constexpr RESULT(const&) operator() (Y&&...y) const && {
+    return call(Args{}, static_cast<const Base&&>(*this),
+                std::forward<Y>(y)...);
   }
 #endif
 
@@ -316,6 +364,39 @@ constexpr auto rclosure = MakeT<rpart_f>{};
 /// Like closure, but forwards its arguments.
 constexpr auto rpart = ForwardT<rpart_f>{};
 
+/// Curried<F, X...> -- The partial application of a multary function given
+/// too few arguments. Applying it to more extends it, rather than nesting it
+/// within another Part.
+template<class F, class...X>
+struct Curried : Part<F, X...> {
+  using Part<F, X...>::Part;
+};
+
+/// Bind<P, F, X...> -- Binds `x...` to `f` as a P<F, X...> or, if `f` is
+/// already Curried, by extending it.
+template<template<class...> class P, class F, class...X>
+struct Bind {
+  using type = P<F, X...>;
+
+  template<class G>
+  static constexpr type make(G&& f, X...x) {
+    return type(std::forward<G>(f), std::forward<X>(x)...);
+  }
+};
+
+template<template<class...> class P, class F, class...Y, class...X>
+struct Bind<P, Curried<F, Y...>, X...> {
+  using type = P<F, Y..., X...>;
+
+  static constexpr type make(const Curried<F, Y...>& f, X...x) {
+    return f.template extend<P, X...>(std::forward<X>(x)...);
+  }
+
+  static constexpr type make(Curried<F, Y...>&& f, X...x) {
+    return std::move(f).template extend<P, X...>(std::forward<X>(x)...);
+  }
+};
+
 /// A function that takes `n` or more arguments. If given only one argument, it
 /// will return a partial application.
 template<size_t n, class _F>
@@ -324,20 +405,43 @@ struct multary_n_f : ToFunctor<_F> {
 
   constexpr multary_n_f(F f) : F(std::move(f)) { }
 
-  // The result of applying this m arguments where m <= n.
+  // The type an argument is bound as, like by closure.
+  template<class X>
+  using Bound = typename MakeT<Part>::template Ty_t<X>;
+
+  // The result of applying this m arguments where m < n.
+  template<class...X>
+  using Partial = multary_n_f<n - sizeof...(X),
+                              typename Bind<Curried, F, Bound<X>...>::type>;
+
+  // The result of applying this exactly n arguments.
   template<class...X>
-  using Partial = multary_n_f<n - sizeof...(X), Part<F, X...>>;
+  using Full = typename Bind<Part, F, Bound<X>...>::type;
 
   /// Too few arguments: Return another multary function.
   template<class...X, class = enable_if_t<(sizeof...(X) < n)>>
   constexpr Partial<X...> operator() (X...x) const & {
-    return Partial<X...>(closure(F(*this), std::move(x)...));
+    return Partial<X...>(Bind<Curried, F, Bound<X>...>::make(
+        static_cast<const F&>(*this), std::move(x)...));
+  }
+
+  template<class...X, class = enable_if_t<(sizeof...(X) < n)>>
+  constexpr Partial<X...> operator() (X...x) && {
+    return Partial<X...>(Bind<Curried, F, Bound<X>...>::make(
+        static_cast<F&&>(*this), std::move(x)...));
   }
 
   /// Exactly n arguments: Partially apply.
   template<class...X, class = enable_if_t<(sizeof...(X) == n)>>
-  constexpr Part<F, X...> operator() (X...x) const & {
-    return closure(F(*this), std::move(x)...);
+  constexpr Full<X...> operator() (X...x) const & {
+    return Bind<Part, F, Bound<X>...>::make(static_cast<const F&>(*this),
+                                            std::move(x)...);
+  }
+
+  template<class...X, class = enable_if_t<(sizeof...(X) == n)>>
+  constexpr Full<X...> operator() (X...x) && {
+    return Bind<Part, F, Bound<X>...>::make(static_cast<F&&>(*this),
+                                            std::move(x)...);
   }
 
   /// More than n arguments: invoke.
@@ -396,4 +500,30 @@ constexpr multary_n_f<n, F> multary_n(F f) {
 }
 #endif  // __clang__
 
+#ifdef __cpp_fold_expressions
+/// Folded<F, X> -- `x`, an operand of `f` in a fold expression: `a | b` is
+/// `f(a, b)`, so `(... | folded(f, x))` folds `x...` from the left and
+/// `(folded(f, x) | ...)` from the right. `|` is instantiated once per pair of
+/// operand types, rather than once per operand as a recursion would be.
+template<class F, class X>
+struct Folded {
+  const F& f;
+  X x;
+
+  template<class Y>
+  constexpr auto operator| (Folded<F, Y>&& y) && {
+    using R = decltype(invoke(f, std::forward<X>(x), std::forward<Y>(y.x)));
+    return Folded<F, R>{f, invoke(f, std::forward<X>(x), std::forward<Y>(y.x))};
+  }
+
+  /// The result of the fold.
+  constexpr X get() && { return std::forward<X>(x); }
+};
+
+template<class F, class X>
+constexpr Folded<F, X&&> folded(const F& f, X&& x) {
+  return {f, std::forward<X>(x)};
+}
+#endif  // __cpp_fold_expressions
+
 } // namspace fu
@@ -4,8 +4,12 @@
 #include <utility>
 #include <functional>
 
+#include <fu/function.h>
 #include <fu/functional.h>
+#include <fu/group.h>
 #include <fu/list.h>
+#include <fu/memo.h>
 #include <fu/meta.h>
+#include <fu/par.h>
 #include <fu/tuple.h>
 #include <fu/utility.h>
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <fu/basic.h>
+#include <fu/invoke.h>
+#include <fu/meta.h>
+
+/// Type-erased function objects.
+
+namespace fu {
+
+template<class Sig, std::size_t InlineBytes = 3 * sizeof(void*)>
+class function;
+
+/// function<R(X...), InlineBytes> -- A move-only, type-erased function.
+///
+/// Like std::function, but function objects of up to InlineBytes that can be
+/// moved without throwing, like most fu closures, are stored inline rather
+/// than on the heap, and need not be copyable. Calls go through a single
+/// indirect call. Does not use RTTI.
+template<class R, class...X, std::size_t InlineBytes>
+class function<R(X...), InlineBytes> {
+  static_assert(InlineBytes >= sizeof(void*),
+                "the inline storage must fit a pointer");
+
+  using Storage = std::aligned_storage_t<InlineBytes,
+                                         alignof(std::max_align_t)>;
+
+  /// Calls the function object stored in `s`.
+  using Call = R(*)(Storage& s, X&&...x);
+
+  /// Moves the function object in `src` to `dst`, or destroys `dst` if `src`
+  /// is null.
+  using Manage = void(*)(Storage& dst, Storage* src);
+
+  template<class F>
+  using IsInline = Bool<sizeof(F) <= InlineBytes &&
+                        alignof(F) <= alignof(std::max_align_t) &&
+                        std::is_nothrow_move_constructible<F>::value>;
+
+  template<class F>
+  struct Inline {
+    static F& get(Storage& s) { return *reinterpret_cast<F*>(&s); }
+
+    template<class G>
+    static void make(Storage& s, G&& g) { new (&s) F(std::forward<G>(g)); }
+
+    static R call(Storage& s, X&&...x) {
+      return invoke(get(s), std::forward<X>(x)...);
+    }
+
+    static void manage(Storage& dst, Storage* src) {
+      if (src) {
+        new (&dst) F(std::move(get(*src)));
+        get(*src).~F();
+      } else {
+        get(dst).~F();
+      }
+    }
+  };
+
+  template<class F>
+  struct Heap {
+    static F*& get(Storage& s) { return *reinterpret_cast<F**>(&s); }
+
+    template<class G>
+    static void make(Storage& s, G&& g) {
+      new (&s) F*(new F(std::forward<G>(g)));
+    }
+
+    static R call(Storage& s, X&&...x) {
+      return invoke(*get(s), std::forward<X>(x)...);
+    }
+
+    static void manage(Storage& dst, Storage* src) {
+      if (src) new (&dst) F*(get(*src));
+      else     delete get(dst);
+    }
+  };
+
+  template<class F>
+  using Impl = std::conditional_t<IsInline<F>::value, Inline<F>, Heap<F>>;
+
+  mutable Storage storage;
+  Call call = nullptr;
+  Manage manage = nullptr;
+
+public:
+  /// Whether function objects of type F are stored inline.
+  template<class F>
+  static constexpr bool is_inline() { return IsInline<std::decay_t<F>>{}; }
+
+  function() = default;
+  function(std::nullptr_t) { }
+
+  template<class F, class D = std::decay_t<F>,
+           class = enable_if_t<!std::is_same<D, function>{}>,
+           class = std::result_of_t<D&(X...)>>
+  function(F&& f) : call(Impl<D>::call), manage(Impl<D>::manage) {
+    Impl<D>::make(storage, std::forward<F>(f));
+  }
+
+  function(function&& other) : call(other.call), manage(other.manage) {
+    if (manage) manage(storage, &other.storage);
+    other.call = nullptr;
+    other.manage = nullptr;
+  }
+
+  function& operator= (function&& other) {
+    if (this != &other) {
+      this->~function();
+      new (this) function(std::move(other));
+    }
+    return *this;
+  }
+
+  function& operator= (std::nullptr_t) {
+    this->~function();
+    return *new (this) function();
+  }
+
+  function(const function&) = delete;
+  function& operator= (const function&) = delete;
+
+  ~function() {
+    if (manage) manage(storage, nullptr);
+  }
+
+  explicit operator bool() const { return call != nullptr; }
+
+  R operator() (X...x) const {
+    if (!call) throw std::bad_function_call();
+    return call(storage, std::forward<X>(x)...);
+  }
+};
+
+template<class Sig>
+class function_ref;
+
+/// function_ref<R(X...)> -- A reference to a function, for parameters.
+///
+/// Binds to any function object or function, without copying or allocating,
+/// as a pointer to it and a pointer to a function that calls it. It is
+/// trivially copyable, so it may be passed in registers. Like any reference,
+/// it must not outlive what it refers to; binding one to a temporary is only
+/// safe as a function parameter.
+///
+/// Ex:
+///   void for_each_line(const File&, fu::function_ref<void(const Line&)>);
+///   for_each_line(file, [&](const Line& l) { count++; });
+template<class R, class...X>
+class function_ref<R(X...)> {
+  union Target {
+    void* obj;
+    void (*fn)();
+  };
+
+  template<class F>
+  static R call_obj(Target t, X&&...x) {
+    return invoke(*static_cast<F*>(t.obj), std::forward<X>(x)...);
+  }
+
+  template<class F>
+  static R call_fn(Target t, X&&...x) {
+    return invoke(reinterpret_cast<F*>(t.fn), std::forward<X>(x)...);
+  }
+
+  Target target;
+  R (*call)(Target, X&&...);
+
+  template<class F>
+  void bind(Bool<false>, F& f) {
+    target.obj = const_cast<void*>(static_cast<const void*>(std::addressof(f)));
+    call = call_obj<F>;
+  }
+
+  template<class F>
+  void bind(Bool<true>, F& f) {
+    target.fn = reinterpret_cast<void(*)()>(&f);
+    call = call_fn<F>;
+  }
+
+public:
+  template<class F, class D = std::remove_reference_t<F>,
+           class = enable_if_t<!std::is_same<std::decay_t<F>,
+                                             function_ref>{}>,
+           class = std::result_of_t<D&(X...)>>
+  function_ref(F&& f) noexcept {
+    bind(std::is_function<D>{}, f);
+  }
+
+  /// Function pointers are bound to the function they point to.
+  template<class F, class = enable_if_t<std::is_function<F>{}>,
+           class = std::result_of_t<F*(X...)>>
+  function_ref(F* f) noexcept {
+    bind(Bool<true>{}, *f);
+  }
+
+  R operator() (X...x) const {
+    return call(target, std::forward<X>(x)...);
+  }
+};
+
+} // namespace fu
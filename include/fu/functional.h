@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <array>
+#include <new>
+#include <tuple>
 #include <utility>
 #include <functional>
 
@@ -24,6 +27,12 @@ struct Rank<0> {
 };
 
 constexpr struct sequence_f {
+#ifdef __cpp_fold_expressions
+  template<class...F>
+  constexpr decltype(auto) operator() (F&&...f) const {
+    return (fu::invoke(std::forward<F>(f)), ...);
+  }
+#else
   template<class F>
   constexpr decltype(auto) operator() (F&& f) const {
     return fu::invoke(std::forward<F>(f));
@@ -35,21 +44,133 @@ constexpr struct sequence_f {
     return fu::invoke(std::forward<F>(f)), (*this)(std::forward<G>(g),
                                                    std::forward<H>(h)...);
   }
+#endif
 } sequence{};
 
+/// Associative<F> -- Declares that `f(f(x,y),z) == f(x,f(y,z))`.
+///
+/// Algorithms that may regroup applications of `f`, like par::foldl and
+/// lassoc, check this before doing so. Specialize it to opt-in user function
+/// objects.
+template<class F>
+struct Associative : Bool<false> { };
+
+/// Commutative<F> -- Declares that `f(x,y) == f(y,x)`.
+template<class F>
+struct Commutative : Bool<false> { };
+
+/// Whether the X... are all of one arithmetic type, once decayed.
+template<class X, class...Y>
+using SameArithmetic =
+  Bool<std::is_arithmetic<std::decay_t<X>>::value &&
+       meta::all<std::is_same<std::decay_t<X>,
+                              std::decay_t<Y>>::value...>::value>;
+
+/// Balanced-tree application.
+struct tree_assoc_f {
+  template<class F, class X, class Y>
+  constexpr decltype(auto) operator() (F&& f, X&& x, Y&& y) const {
+    return invoke(std::forward<F>(f), std::forward<X>(x), std::forward<Y>(y));
+  }
+
+  template<class F, class X, class Y, class...Z,
+           class = enable_if_t<(sizeof...(Z) > 0)>>
+  constexpr decltype(auto) operator() (const F& f, X&& x, Y&& y, Z&&...z) const {
+    constexpr size_t n = sizeof...(Z) + 2;
+    auto&& args = store(SameArithmetic<X, Y, Z...>{}, std::forward<X>(x),
+                        std::forward<Y>(y), std::forward<Z>(z)...);
+    return tree(f, args, Size<0>{}, Size<n>{}, Bool<false>{});
+  }
+
+private:
+  // Numbers are copied into an array, where finding each costs nothing to
+  // compile; anything else is referred to by a Compressed.
+  template<class X, class...Y>
+  static constexpr std::array<std::decay_t<X>, sizeof...(Y) + 1>
+  store(Bool<true>, X&& x, Y&&...y) {
+    return {{x, y...}};
+  }
+
+  template<class...X>
+  static constexpr auto store(Bool<false>, X&&...x) {
+    return tpl::Compressed<X&&...>(tpl::FromElems{}, std::forward<X>(x)...);
+  }
+
+  template<size_t i, class T, size_t n>
+  static constexpr T elem(const std::array<T, n>& a, Size<i>) {
+    return std::get<i>(a);
+  }
+
+  template<size_t i, class Is, class...X>
+  static constexpr decltype(auto) elem(tpl::CompressedImpl<Is, X...>& args,
+                                       Size<i>) {
+    return std::move(args).template get<i>();
+  }
+
+  // Applies `f` to the arguments [b, e). Each range takes one instantiation,
+  // and they nest only log(n) deep.
+  template<class F, class Args, size_t b, size_t e>
+  static constexpr decltype(auto) tree(const F&, Args& args,
+                                       Size<b>, Size<e>, Bool<true>) {
+    return elem(args, Size<b>{});
+  }
+
+  template<class F, class Args, size_t b, size_t e>
+  static constexpr decltype(auto) tree(const F& f, Args& args,
+                                       Size<b>, Size<e>, Bool<false>) {
+    constexpr size_t m = b + (e - b) / 2;
+    // The left half is applied first, as it would be by lassoc.
+    auto&& l = tree(f, args, Size<b>{}, Size<m>{}, Bool<m - b == 1>{});
+    return invoke(f, std::forward<decltype(l)>(l),
+                  tree(f, args, Size<m>{}, Size<e>{}, Bool<e - m == 1>{}));
+  }
+};
+
+/// tree_assoc(f) -- Applies `f` to its arguments pairwise, as a balanced tree,
+/// so that the applications in each half may run in parallel. Only sensible
+/// for associative functions.
+///
+/// Ex: tree_assoc(+)(1,2,3,4) = (1+2) + (3+4)
+constexpr auto tree_assoc = multary(tree_assoc_f{});
+
 struct lassoc_f {
   template<class F, class X, class Y>
   constexpr decltype(auto) operator() (F&& f, X&& x, Y&& y) const {
     return invoke(std::forward<F>(f), std::forward<X>(x), std::forward<Y>(y));
   }
 
+  /// If `f` is Associative and the arguments all of one arithmetic type, so
+  /// that regrouping them changes neither their types nor, but for rounding,
+  /// the result, they are applied as a balanced tree.
   template<class F, class X, class Y, class...Z,
            class = enable_if_t<(sizeof...(Z) > 0)>>
   constexpr decltype(auto) operator() (const F& f, X&& x, Y&& y, Z&&...z) const {
+    using Tree = Bool<Associative<F>::value &&
+                      SameArithmetic<X, Y, Z...>::value>;
+    return fold(Tree{}, f, std::forward<X>(x), std::forward<Y>(y),
+                std::forward<Z>(z)...);
+  }
+
+private:
+#ifdef __cpp_fold_expressions
+  template<class F, class...X>
+  constexpr decltype(auto) fold(Bool<false>, const F& f, X&&...x) const {
+    return (... | folded(f, std::forward<X>(x))).get();
+  }
+#else
+  template<class F, class X, class Y, class...Z>
+  constexpr decltype(auto) fold(Bool<false>, const F& f,
+                                X&& x, Y&& y, Z&&...z) const {
     return (*this)(f,
                    invoke(f, std::forward<X>(x), std::forward<Y>(y)),
                    std::forward<Z>(z)...);
   }
+#endif
+
+  template<class F, class...X>
+  constexpr decltype(auto) fold(Bool<true>, const F& f, X&&...x) const {
+    return tree_assoc_f{}(f, std::forward<X>(x)...);
+  }
 };
 
 /// Right-associative application.
@@ -62,8 +183,13 @@ struct rassoc_f {
   template<class F, class X, class...Y
           ,class = std::enable_if_t<(sizeof...(Y) > 1)>>
   constexpr decltype(auto) operator() (const F& f, X&& x, Y&&...y) const {
+#ifdef __cpp_fold_expressions
+    return (folded(f, std::forward<X>(x)) |
+            (folded(f, std::forward<Y>(y)) | ...)).get();
+#else
     return invoke(f, std::forward<X>(x),
                   (*this)(f, std::forward<Y>(y)...));
+#endif
   }
 };
 
@@ -72,6 +198,81 @@ struct rassoc_f {
 /// Ex: lassoc(+)(1,2,3) = (1+2) + 3
 constexpr auto lassoc = multary(lassoc_f{});
 
+// multary, lassoc and tree_assoc preserve the properties of the decorated function.
+template<size_t n, class F>
+struct Associative<multary_n_f<n, F>> : Associative<ToFunctor<F>> { };
+
+template<size_t n, class F>
+struct Commutative<multary_n_f<n, F>> : Commutative<ToFunctor<F>> { };
+
+template<class F>
+struct Associative<Part<lassoc_f, F>> : Associative<F> { };
+
+template<class F>
+struct Commutative<Part<lassoc_f, F>> : Commutative<F> { };
+
+template<class F>
+struct Associative<Part<tree_assoc_f, F>> : Associative<F> { };
+
+template<class F>
+struct Commutative<Part<tree_assoc_f, F>> : Commutative<F> { };
+
+/// The binary operation underlying a function decorated by multary, lassoc or
+/// tree_assoc.
+///
+/// Ex: Undecorated<decltype(numeric_binary(f))> = decltype(f)
+template<class F>
+struct Undecorated { using type = F; };
+
+template<size_t n, class F>
+struct Undecorated<multary_n_f<n, F>> : Undecorated<ToFunctor<F>> { };
+
+template<class F>
+struct Undecorated<Part<lassoc_f, F>> : Undecorated<F> { };
+
+template<class F>
+struct Undecorated<Part<tree_assoc_f, F>> : Undecorated<F> { };
+
+template<class F>
+using Undecorated_t = typename Undecorated<std::decay_t<F>>::type;
+
+/// InPlace<F>::update(f, x, y) -- Updates `x` to `f(x, y)` without copying it.
+///
+/// By default, `x` is moved into `f`. Operators with a compound-assignment
+/// form, like `add` (`add_eq`), use it instead. foldl uses this for its
+/// accumulator; specialize it to customize user function objects.
+template<class F>
+struct InPlace {
+  template<class G, class X, class Y>
+  static void update(const G& g, X& x, Y&& y) {
+    x = invoke(g, std::move(x), std::forward<Y>(y));
+  }
+};
+
+template<size_t n, class F>
+struct InPlace<multary_n_f<n, F>> {
+  template<class X, class Y>
+  static void update(const ToFunctor<F>& f, X& x, Y&& y) {
+    InPlace<ToFunctor<F>>::update(f, x, std::forward<Y>(y));
+  }
+};
+
+template<class F>
+struct InPlace<Part<lassoc_f, F>> {
+  template<class X, class Y>
+  static void update(const Part<lassoc_f, F>& p, X& x, Y&& y) {
+    InPlace<F>::update(p.template arg<0>(), x, std::forward<Y>(y));
+  }
+};
+
+template<class F>
+struct InPlace<Part<tree_assoc_f, F>> {
+  template<class X, class Y>
+  static void update(const Part<tree_assoc_f, F>& p, X& x, Y&& y) {
+    InPlace<F>::update(p.template arg<0>(), x, std::forward<Y>(y));
+  }
+};
+
 struct transitive_f {
   /// trans(b,j,x,y) = b(x,y)
   template<class Binary, class Join, class X, class Y>
@@ -282,6 +483,96 @@ struct fix_f {
 ///   });
 constexpr auto fix = multary(fix_f{});
 
+/// The arguments of a tail call, as returned by the `rec` of fix_tc.
+template<class...X>
+struct TailArgs {
+  std::tuple<X...> args;
+};
+
+struct tail_rec_f {
+  template<class...X>
+  constexpr TailArgs<std::decay_t<X>...> operator() (X&&...x) const {
+    return {std::tuple<std::decay_t<X>...>(std::forward<X>(x)...)};
+  }
+};
+
+/// TailCall<R(X...)> -- The result of a step of fix_tc: either the final
+/// result, an R, or the arguments, X..., of the next step.
+template<class Sig>
+class TailCall;
+
+template<class R, class...X>
+class TailCall<R(X...)> {
+  using Args = std::tuple<X...>;
+
+  bool done_;
+  union {
+    R r;
+    Args args;
+  };
+
+public:
+  TailCall(R r) : done_(true), r(std::move(r)) { }
+
+  template<class...Y>
+  TailCall(TailArgs<Y...> a) : done_(false), args(std::move(a.args)) { }
+
+  TailCall(TailCall&& other) : done_(other.done_) {
+    if (done_) new (&r) R(std::move(other.r));
+    else       new (&args) Args(std::move(other.args));
+  }
+
+  TailCall& operator= (TailCall&& other) {
+    this->~TailCall();
+    return *new (this) TailCall(std::move(other));
+  }
+
+  ~TailCall() {
+    if (done_) r.~R();
+    else       args.~Args();
+  }
+
+  bool done() const { return done_; }
+  R& result() { return r; }
+  Args& arguments() { return args; }
+};
+
+struct fix_tc_f {
+  template<class F, class Args, std::size_t...i>
+  static decltype(auto) step(const F& f, Args&& args,
+                             std::index_sequence<i...>) {
+    return f(tail_rec_f{}, std::get<i>(std::move(args))...);
+  }
+
+  template<class F, class...X>
+  auto operator() (const F& f, X&&...x) const {
+    auto t = f(tail_rec_f{}, std::forward<X>(x)...);
+    while (!t.done()) {
+      auto& args = t.arguments();
+      using Is = std::make_index_sequence<
+        std::tuple_size<std::decay_t<decltype(args)>>::value>;
+      t = step(f, std::move(args), Is{});
+    }
+    return std::move(t.result());
+  }
+};
+
+/// Trampolined fixed-point combinator: fix_tc(f, x) <=> fix(f, x), for `f`
+/// whose recursive calls are tail calls, but in constant stack space.
+///
+/// Instead of calling itself, `f` returns `rec(y...)`, the arguments of its
+/// next call, or its result, and fix_tc calls it again in a loop until it
+/// returns a result. Its return type must be declared as TailCall<R(X...)>:
+/// the result type and the types of its arguments, excluding `rec`.
+///
+/// Ex:
+///   auto length = fix_tc([](auto rec, const Node* n, std::size_t len)
+///                          -> TailCall<std::size_t(const Node*, std::size_t)> {
+///     if (!n) return len;
+///     return rec(n->next, len + 1);
+///   });
+constexpr auto fix_tc = multary(fix_tc_f{});
+
 struct proj_f {
   template<class F, class ProjF, class...X,
            class = enable_if_t<(sizeof...(X) > 0)>>
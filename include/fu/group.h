@@ -0,0 +1,249 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <fu/functional.h>
+#include <fu/par.h>
+#include <fu/utility.h>
+
+/// Hash aggregation: grouping the elements of a range by key and folding each
+/// group.
+
+namespace fu {
+
+/// Groups<K, X> -- A hash table from keys, K, to accumulators, X.
+///
+/// The (key, accumulator) pairs are stored contiguously, in the order their
+/// keys were first inserted, so iterating over them is a linear scan. Lookups
+/// go through an open-addressing (linear probing) index of slots, each a
+/// hash and a position in the pairs, which keeps probes within a few cache
+/// lines. Groups may only grow.
+template<class K, class X,
+         class Hash = std::hash<K>, class Eq = std::equal_to<K>>
+class Groups {
+public:
+  using key_type = K;
+  using mapped_type = X;
+  using value_type = std::pair<K, X>;
+  using iterator = typename std::vector<value_type>::iterator;
+  using const_iterator = typename std::vector<value_type>::const_iterator;
+
+private:
+  struct Slot {
+    std::uint64_t hash;
+    std::size_t pos;  // One past the pair's position; zero if empty.
+  };
+
+  std::vector<Slot> slots;
+  std::vector<value_type> groups;
+  Hash hasher;
+  Eq eq;
+
+  /// Spreads the bits of `h` so that nearby hashes, like those std::hash
+  /// gives nearby integers, do not probe nearby slots (Fibonacci hashing).
+  static std::uint64_t mix(std::uint64_t h) {
+    return h * 0x9E3779B97F4A7C15ull;
+  }
+
+  std::size_t home(std::uint64_t h) const {
+    return (mix(h) >> 32) & (slots.size() - 1);
+  }
+
+  void rehash(std::size_t n) {
+    std::vector<Slot> old(n, Slot{0, 0});
+    std::swap(slots, old);
+    for (const Slot& s : old) {
+      if (!s.pos) continue;
+      std::size_t i = home(s.hash);
+      while (slots[i].pos) i = (i + 1) & (slots.size() - 1);
+      slots[i] = s;
+    }
+  }
+
+public:
+  Groups() = default;
+
+  explicit Groups(std::size_t n, Hash h = Hash{}, Eq e = Eq{})
+    : hasher(std::move(h)), eq(std::move(e))
+  {
+    reserve(n);
+  }
+
+  /// Makes room for `n` groups without rehashing.
+  void reserve(std::size_t n) {
+    std::size_t cap = 16;
+    while (cap < 2 * n) cap *= 2;
+    if (cap > slots.size()) rehash(cap);
+    groups.reserve(n);
+  }
+
+  std::uint64_t hash(const K& k) const { return hasher(k); }
+
+  /// The accumulator of the group of `k`, whose hash is `h`, inserting
+  /// `x0` if it has none.
+  template<class Y>
+  X& get(std::uint64_t h, const K& k, Y&& x0) {
+    if (2 * (groups.size() + 1) > slots.size())
+      rehash(slots.empty() ? 16 : 2 * slots.size());
+
+    std::size_t i = home(h);
+    for (; slots[i].pos; i = (i + 1) & (slots.size() - 1)) {
+      auto& g = groups[slots[i].pos - 1];
+      if (slots[i].hash == h && eq(g.first, k)) return g.second;
+    }
+
+    groups.emplace_back(k, std::forward<Y>(x0));
+    slots[i] = Slot{h, groups.size()};
+    return groups.back().second;
+  }
+
+  template<class Y>
+  X& get(const K& k, Y&& x0) {
+    return get(hash(k), k, std::forward<Y>(x0));
+  }
+
+  /// The accumulator of the group of `k`, or nullptr.
+  const X* find(const K& k) const {
+    if (groups.empty()) return nullptr;
+    std::uint64_t h = hash(k);
+    for (std::size_t i = home(h); slots[i].pos;
+         i = (i + 1) & (slots.size() - 1)) {
+      auto& g = groups[slots[i].pos - 1];
+      if (slots[i].hash == h && eq(g.first, k)) return &g.second;
+    }
+    return nullptr;
+  }
+
+  iterator begin() { return groups.begin(); }
+  iterator end()   { return groups.end(); }
+  const_iterator begin() const { return groups.begin(); }
+  const_iterator end()   const { return groups.end(); }
+
+  std::size_t size() const { return groups.size(); }
+  bool empty() const { return groups.empty(); }
+};
+
+template<class KF, class X, class Xs>
+using GroupsOf =
+  Groups<std::decay_t<decltype(invoke(std::declval<const KF&>(),
+                                      *std::begin(std::declval<Xs&>())))>,
+         X>;
+
+struct group_by_f {
+  template<class KF, class F, class X, class Xs>
+  GroupsOf<KF, X, Xs> operator() (const KF& kf, const F& f, X x0,
+                                  Xs&& xs) const
+  {
+    GroupsOf<KF, X, Xs> groups;
+    for (auto&& x : xs)
+      InPlace<std::decay_t<F>>::update(f, groups.get(invoke(kf, x), x0), x);
+    return groups;
+  }
+};
+
+/// group_by(kf, f, x, xs) -- For each distinct key, `kf(x)`, of the elements
+/// of `xs`, the fold, foldl(f, x, ...), of the elements with that key, as a
+/// Groups table.
+///
+/// Ex:
+///   auto totals = group_by(&Sale::region, rproj(add, &Sale::amount), 0, sales);
+///   for (auto& g : totals) print(g.first, g.second);
+constexpr auto group_by = multary_n<3>(group_by_f{});
+
+namespace par {
+
+struct group_by_f {
+  /// A row of the input and the hash of its key.
+  struct Row {
+    std::size_t index;
+    std::uint64_t hash;
+  };
+
+  /// The partition of a key's hash. Uses different bits than Groups uses for
+  /// its slots, so a partition's keys do not crowd together in its table.
+  static std::size_t partition(std::uint64_t h, std::size_t parts) {
+    return ((h * 0xC2B2AE3D27D4EB4Full) >> 32) & (parts - 1);
+  }
+
+  template<class KF, class F, class X, class Xs>
+  static GroupsOf<KF, X, Xs> aggregate(Bool<false>, const KF& kf, const F& f,
+                                       X x0, Xs&& xs)
+  {
+    return fu::group_by(kf, f, std::move(x0), std::forward<Xs>(xs));
+  }
+
+  /// Partitions the rows by the hash of their keys, then aggregates each
+  /// partition on its own thread. Each group belongs to exactly one
+  /// partition, so the threads share nothing and need no combining step.
+  template<class KF, class F, class X, class Xs>
+  static GroupsOf<KF, X, Xs> aggregate(Bool<true>, const KF& kf, const F& f,
+                                       X x0, Xs&& xs)
+  {
+    using G = GroupsOf<KF, X, Xs>;
+    auto first = std::begin(xs);
+    std::size_t n = std::distance(first, std::end(xs));
+    std::size_t k = std::min(concurrency(), n / min_grain);
+    if (k < 2) return aggregate(Bool<false>{}, kf, f, std::move(x0), xs);
+
+    std::size_t parts = 1;
+    while (parts < 4 * k) parts *= 2;
+
+    // rows[t][p]: the rows of chunk t in partition p, in order.
+    G hasher;
+    auto rows = run_n(k, [&](std::size_t t) {
+      std::vector<std::vector<Row>> rs(parts);
+      for (std::size_t i = n * t / k; i < n * (t+1) / k; i++) {
+        std::uint64_t h = hasher.hash(invoke(kf, first[i]));
+        rs[partition(h, parts)].push_back(Row{i, h});
+      }
+      return rs;
+    });
+
+    std::vector<G> tables(parts);
+    for_each_batch(parts, [&](std::size_t lo, std::size_t hi) {
+      for (std::size_t p = lo; p < hi; p++) {
+        for (auto& chunk : rows) {
+          for (const Row& r : chunk[p]) {
+            auto&& x = first[r.index];
+            X& acc = tables[p].get(r.hash, invoke(kf, x), x0);
+            InPlace<std::decay_t<F>>::update(f, acc, x);
+          }
+        }
+      }
+    });
+
+    std::size_t total = 0;
+    for (auto& t : tables) total += t.size();
+    G groups(total);
+    for (auto& t : tables) {
+      for (auto& g : t) {
+        groups.get(groups.hash(g.first), g.first, std::move(g.second));
+      }
+    }
+    return groups;
+  }
+
+  template<class KF, class F, class X, class Xs>
+  GroupsOf<KF, X, Xs> operator() (const KF& kf, const F& f, X x0,
+                                  Xs&& xs) const
+  {
+    return aggregate(IsRandomAccess<Xs>{}, kf, f, std::move(x0),
+                     std::forward<Xs>(xs));
+  }
+};
+
+/// par::group_by(kf, f, x, xs) <=> group_by(kf, f, x, xs), up to the order
+/// of the groups.
+///
+/// If `xs` is random-access, each thread hashes the keys of one chunk of `xs`
+/// and scatters its rows into partitions by hash, then each partition is
+/// aggregated by one thread. Since each group is folded by one thread in the
+/// order of `xs`, `f` need not be associative.
+constexpr auto group_by = multary_n<3>(group_by_f{});
+
+} // namespace par
+} // namespace fu
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/// Sources of data for the algorithms in "fu/list.h". POSIX only.
+
+namespace fu {
+namespace io {
+
+/// A contiguous range of records, [first, last).
+template<class T>
+struct range {
+  T* first;
+  T* last;
+
+  T* begin() const { return first; }
+  T* end()   const { return last; }
+
+  std::size_t size() const { return last - first; }
+  bool empty() const { return first == last; }
+
+  T& operator[] (std::size_t i) const { return first[i]; }
+};
+
+/// mapped_range<T> -- The records of a binary file, mapped into memory.
+///
+/// The file is mapped with madvise(MADV_SEQUENTIAL) so the kernel reads ahead
+/// and drops pages behind the reader. If `T` is const, the mapping is
+/// read-only; otherwise it is private (copy-on-write) so algorithms like
+/// `transform` may modify records without writing to the file. Trailing bytes
+/// that do not make up a whole record are ignored.
+///
+/// Ex:
+///   fu::io::mapped_range<const Record> records("data.bin");
+///   auto total = fu::foldl(fu::rproj(fu::add, &Record::amount), 0, records);
+template<class T>
+class mapped_range {
+  static_assert(std::is_trivially_copyable<T>{},
+                "records must be trivially copyable");
+
+  void* addr = nullptr;
+  std::size_t bytes = 0;
+
+  static constexpr int prot = std::is_const<T>{} ? PROT_READ
+                                                 : PROT_READ | PROT_WRITE;
+
+  static void fail(const std::string& what, const std::string& path) {
+    throw std::system_error(errno, std::generic_category(), what + " " + path);
+  }
+
+public:
+  /// Maps the file at `path`. With `huge_pages`, advises the kernel to back
+  /// the mapping with transparent huge pages, where supported.
+  explicit mapped_range(const std::string& path, bool huge_pages = false) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) fail("open", path);
+
+    struct stat st;
+    if (::fstat(fd, &st) < 0) {
+      ::close(fd);
+      fail("stat", path);
+    }
+
+    bytes = st.st_size - st.st_size % sizeof(T);
+    if (bytes) {
+      addr = ::mmap(nullptr, bytes, prot, MAP_PRIVATE, fd, 0);
+      if (addr == MAP_FAILED) {
+        addr = nullptr;
+        ::close(fd);
+        fail("mmap", path);
+      }
+    }
+    ::close(fd);
+
+    if (addr) {
+      ::madvise(addr, bytes, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+      if (huge_pages) ::madvise(addr, bytes, MADV_HUGEPAGE);
+#else
+      (void)huge_pages;
+#endif
+    }
+  }
+
+  mapped_range(const mapped_range&) = delete;
+  mapped_range& operator= (const mapped_range&) = delete;
+
+  mapped_range(mapped_range&& other) noexcept
+    : addr(std::exchange(other.addr, nullptr))
+    , bytes(std::exchange(other.bytes, 0))
+  {
+  }
+
+  mapped_range& operator= (mapped_range&& other) noexcept {
+    std::swap(addr, other.addr);
+    std::swap(bytes, other.bytes);
+    return *this;
+  }
+
+  ~mapped_range() {
+    if (addr) ::munmap(addr, bytes);
+  }
+
+  T* begin() const { return static_cast<T*>(addr); }
+  T* end()   const { return begin() + size(); }
+
+  std::size_t size() const { return bytes / sizeof(T); }
+  bool empty() const { return bytes == 0; }
+
+  T& operator[] (std::size_t i) const { return begin()[i]; }
+
+  /// The i'th of `n` nearly equal chunks, for parallel consumers.
+  range<T> chunk(std::size_t i, std::size_t n) const {
+    return {begin() + size() * i / n, begin() + size() * (i+1) / n};
+  }
+};
+
+} // namespace io
+} // namespace fu
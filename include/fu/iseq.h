@@ -1,6 +1,6 @@
-
 #pragma once
 
+#include <cstddef>
 #include <utility>
 #include <functional>
 
@@ -36,38 +36,74 @@ constexpr auto push(std::integer_sequence<I, N...>, Integer<I, M>)
   return {};
 }
 
-template<size_t X, class I, I...N,
-         class = typename std::enable_if<(X == 0)>::type>
+/// Values<I, N...>::at[k] -- The k'th of N.
+///
+/// One instantiation serves every index, so selecting n elements takes a
+/// constant number of instantiations rather than one per element.
+template<class I, I...N>
+struct Values {
+  static constexpr I at[] = {N..., I()};  // Never empty.
+};
+
+template<class I, I...N>
+constexpr I Values<I, N...>::at[];
+
+/// select<Offset, Step>(seq, index_sequence<j...>) =
+///   {seq[Offset + Step * j]...}
+template<std::size_t Offset, std::ptrdiff_t Step, class I, I...N,
+         std::size_t...j>
+constexpr auto select(std::integer_sequence<I, N...>, std::index_sequence<j...>)
+  -> std::integer_sequence<
+       I, Values<I, N...>::at[Offset + Step * std::ptrdiff_t(j)]...>
+{
+  return {};
+}
+
+/// slice<B, E>({n...}) -- The elements of indices B through E-1.
+template<std::size_t B, std::size_t E, class I, I...N>
+constexpr auto slice(std::integer_sequence<I, N...> i) {
+  static_assert(B <= E && E <= sizeof...(N), "Index too high.");
+  return select<B, 1>(i, std::make_index_sequence<E - B>{});
+}
+
+template<std::size_t X, class I, I...N>
 constexpr auto drop(std::integer_sequence<I, N...> i) {
-  return i;
+  static_assert(X <= sizeof...(N), "Index too high.");
+  return slice<X, sizeof...(N)>(i);
 }
 
-template<size_t X, class I, I N, I...M,
-         class = typename std::enable_if<(X > 0)>::type>
-constexpr auto drop(std::integer_sequence<I, N, M...>) {
-  static_assert(X <= sizeof...(M) + 1, "Index too high.");
-  return drop<X - 1>(std::integer_sequence<I, M...>{});
+template<std::size_t X, class I, I...N>
+constexpr auto take(std::integer_sequence<I, N...> i) {
+  static_assert(X <= sizeof...(N), "Index too high.");
+  return slice<0, X>(i);
 }
 
-template<size_t X, class I, I...N, I...M,
-         class = typename std::enable_if<(X == 0)>::type>
-constexpr auto take(std::integer_sequence<I, N...> i,
-                    std::integer_sequence<I, M...>) {
+/// reverse({a, b, c}) = {c, b, a}
+template<class I, I...N>
+constexpr auto reverse(std::integer_sequence<I, N...> i) {
+  return select<sizeof...(N) - 1, -1>(
+      i, std::make_index_sequence<sizeof...(N)>{});
+}
+
+/// concat({n...}, {m...}, ...) = {n..., m..., ...}
+template<class I, I...N>
+constexpr auto concat(std::integer_sequence<I, N...> i) {
   return i;
 }
 
-template<size_t X, class I, I...N, I M, I...Ms,
-         class = typename std::enable_if<(X > 0)>::type>
-constexpr auto take(std::integer_sequence<I, N...> i,
-                    std::integer_sequence<I, M, Ms...> j)
+template<class I, I...N, I...M, class...Seq>
+constexpr auto concat(std::integer_sequence<I, N...>,
+                      std::integer_sequence<I, M...>, Seq...s)
 {
-  static_assert(X <= sizeof...(Ms) + 1, "Index too high.");
-  return take<X - 1>(push(i, Integer<I,M>{}), drop<1>(j));
+  return concat(std::integer_sequence<I, N..., M...>{}, s...);
 }
 
-template<size_t X, class I, I...N>
-constexpr auto take(std::integer_sequence<I, N...> i)
-{ return take<X>(std::integer_sequence<I>{}, i);
+/// take<X>(i, j) = concat(i, take<X>(j))
+template<std::size_t X, class I, I...N, I...M>
+constexpr auto take(std::integer_sequence<I, N...> i,
+                    std::integer_sequence<I, M...> j)
+{
+  return concat(i, take<X>(j));
 }
 
 } // namespace iseq
@@ -1,42 +1,625 @@
 
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include <fu/functional.h>
+#include <fu/simd.h>
+#include <fu/utility.h>
 
 namespace fu {
 
-//template<class Xs>
-//struct Remap;
-//
-//template<class X>
-//struct Remap<std::vector<X>> {
-//  template<class Y>
-//  using type = std::vector<Y>;
-//};
-//
-//template<class X>
-//struct Remap<std::vector<X>> {
-//  template<class Y>
-//  using type = std::vector<Y>;
-//};
+/// Remap<Xs>::type<Y> -- A container like `Xs`, but of `Y`s.
+///
+/// Ranges without a specialization, like views, remap to std::vector.
+template<class Xs>
+struct Remap {
+  template<class Y>
+  using type = std::vector<Y>;
+};
+
+template<class X, class A>
+struct Remap<std::vector<X, A>> {
+  template<class Y>
+  using type =
+    std::vector<Y, typename std::allocator_traits<A>::template rebind_alloc<Y>>;
+};
+
+template<class X, std::size_t N>
+struct Remap<std::array<X, N>> {
+  template<class Y>
+  using type = std::array<Y, N>;
+};
+
+template<class Xs, class Y>
+using Remap_t = typename Remap<std::decay_t<Xs>>::template type<Y>;
 
 struct transform_f {
   template<class F, class Xs>
-  Xs& operator() (const F& f, Xs& xs) const {
+  static Xs& map(Rank<0>, const F& f, Xs& xs) {
     for (auto& x : xs) x = f(x);
     return xs;
   }
+
+  /// Partial applications of arithmetic operators, like `add(5)`, over
+  /// contiguous arithmetic elements dispatch to explicit vector kernels.
+  template<class G, class K, class Xs,
+           class Op = Undecorated_t<G>, class T = simd::Element_t<Xs>,
+           class = enable_if_t<simd::Supported<Op, T, std::decay_t<K>>{}>>
+  static Xs& map(Rank<1>, const Part<G, K>& f, Xs& xs) {
+    if (size(xs)) simd::transform<Op>(T(f.template arg<0>()), &xs[0], size(xs));
+    return xs;
+  }
+
+  template<class F, class Xs>
+  Xs& operator() (const F& f, Xs& xs) const {
+    return map(Rank<1>{}, f, xs);
+  }
 };
 
 constexpr auto transform = multary(transform_f{});
 
+struct map_into_f {
+  /// Containers that grow: reuse the storage of `ys` and reserve the size
+  /// of `xs`, when known, at most once.
+  template<class Ys, class Xs, class F>
+  static auto fill(Rank<1>, Ys& ys, const Xs& xs, const F& f)
+    -> decltype(ys.push_back(invoke(f, *std::begin(xs))), void())
+  {
+    ys.clear();
+    reserve(Rank<1>{}, ys, xs);
+    for (auto&& x : xs) ys.push_back(invoke(f, x));
+  }
+
+  /// Fixed-size containers, like std::array.
+  template<class Ys, class Xs, class F>
+  static void fill(Rank<0>, Ys& ys, const Xs& xs, const F& f) {
+    auto y = std::begin(ys);
+    for (auto&& x : xs) *y++ = invoke(f, x);
+  }
+
+  template<class Ys, class Xs>
+  static auto reserve(Rank<1>, Ys& ys, const Xs& xs)
+    -> decltype(ys.reserve(xs.size()))
+  {
+    ys.reserve(xs.size());
+  }
+
+  template<class Ys, class Xs>
+  static void reserve(Rank<0>, Ys&, const Xs&) { }
+
+  /// map_into(f, xs, ys) -- Assigns `f(x)` for each `x` in `xs` to `ys`.
+  template<class F, class Xs, class Ys>
+  Ys& operator() (const F& f, const Xs& xs, Ys& ys) const {
+    fill(Rank<1>{}, ys, xs, f);
+    return ys;
+  }
+
+  /// map_into(f, xs) -- A new container of `f(x)` for each `x` in `xs`.
+  template<class F, class Xs,
+           class X = decltype(*std::begin(std::declval<const Xs&>())),
+           class Y = std::decay_t<decltype(invoke(std::declval<const F&>(),
+                                                  std::declval<X>()))>>
+  Remap_t<Xs, Y> operator() (const F& f, const Xs& xs) const {
+    Remap_t<Xs, Y> ys;
+    fill(Rank<1>{}, ys, xs, f);
+    return ys;
+  }
+};
+
+/// map_into(f, xs) -- Like transform, but `f` may change the element type;
+/// the result's type is chosen by Remap.
+///
+/// map_into(f, xs, ys) -- Writes the result to `ys`, reusing its storage, so
+/// that calling it repeatedly with the same `ys` need not allocate.
+constexpr auto map_into = multary(map_into_f{});
+
+/// A floating-point sum that accumulates the low-order bits lost to rounding
+/// in a separate compensation term (Kahan-Neumaier summation).
+template<class X>
+struct Compensated {
+  X s = 0, c = 0;
+
+  void add(X y) {
+    X t = s + y;
+    c += std::abs(s) >= std::abs(y) ? (s - t) + y : (y - t) + s;
+    s = t;
+  }
+
+  void add(const Compensated& o) {
+    add(o.s);
+    c += o.c;
+  }
+
+  X value() const { return s + c; }
+};
+
+/// compensated_add(x, y) <=> x + y
+///
+/// As the function of a fold over floating-point values, foldl and par::foldl
+/// compute an accurate and reproducible sum: the elements are summed in
+/// fixed-size blocks, each with a fixed number of interleaved, compensated
+/// sums (lanes) that the compiler may vectorize. The lanes, then the blocks,
+/// are combined as a balanced tree. Since neither the blocks nor the order of
+/// combining them depends on the number of threads, parallel and sequential
+/// folds produce identical results.
+constexpr struct compensated_add_f {
+  static constexpr std::size_t lanes = 8;
+  static constexpr std::size_t block_size = 1024;
+
+  template<class X, class Y>
+  constexpr auto operator() (X&& x, Y&& y) const
+    -> decltype(std::forward<X>(x) + std::forward<Y>(y))
+  {
+    return std::forward<X>(x) + std::forward<Y>(y);
+  }
+
+  /// Combines the sums, [p, p + n), as a balanced tree.
+  template<class X>
+  static Compensated<X> pairwise(const Compensated<X>* p, std::size_t n) {
+    if (n == 1) return p[0];
+    auto sum = pairwise(p, n / 2);
+    sum.add(pairwise(p + n / 2, n - n / 2));
+    return sum;
+  }
+
+  /// Sums one block of up to block_size elements from `it`.
+  template<class X, class It>
+  static Compensated<X> block(It& it, const It& last) {
+    Compensated<X> acc[lanes];
+    for (std::size_t i = 0; i < block_size && it != last; i++, ++it)
+      acc[i % lanes].add(X(*it));
+    return pairwise(acc, lanes);
+  }
+
+  /// x0 plus the sum of the per-block sums.
+  template<class X>
+  static X total(X x0, const std::vector<Compensated<X>>& blocks) {
+    Compensated<X> sum{x0, 0};
+    if (!blocks.empty()) sum.add(pairwise(blocks.data(), blocks.size()));
+    return sum.value();
+  }
+} compensated_add{};
+
 struct foldl_f {
+  /// The accumulator is updated in place (see InPlace), never copied.
   template<class F, class X, class Xs>
   constexpr X operator() (const F& f, X x0, Xs&& xs) const {
     for (auto it = std::begin(xs); it != std::end(xs); it++)
-    x0 = f(x0, *it);
-    return std::move(x0);
+      InPlace<std::decay_t<F>>::update(f, x0, *it);
+    return x0;
+  }
+
+  /// Accurate, reproducible floating-point summation.
+  template<class X, class Xs>
+  X operator() (const compensated_add_f&, X x0, Xs&& xs) const {
+    static_assert(std::is_floating_point<X>{},
+                  "compensated_add folds floating-point values");
+    std::vector<Compensated<X>> blocks;
+    auto it = std::begin(xs), last = std::end(xs);
+    while (it != last) blocks.push_back(compensated_add_f::block<X>(it, last));
+    return compensated_add_f::total(x0, blocks);
+  }
+};
+
+/// foldl(f, x, xs) = f(...f(f(x, xs[0]), xs[1])..., xs[n])
+/// foldl(f, x) -- a partial application awaiting `xs`.
+constexpr auto foldl = multary_n<2>(foldl_f{});
+
+/// Scans [first, last) in place, from left to right, with an accumulator.
+/// Each returns the final accumulator.
+struct scan_f {
+  /// Inclusive: each x becomes `acc = f(acc, x)`.
+  template<class F, class X, class It>
+  static X inclusive(Rank<0>, const F& f, X acc, It first, It last) {
+    for (; first != last; ++first) {
+      InPlace<std::decay_t<F>>::update(f, acc, *first);
+      *first = acc;
+    }
+    return acc;
+  }
+
+  /// Operators like `add` and `bit_or` over contiguous integers scan in
+  /// registers.
+  template<class F, class X, class T,
+           class Op = Undecorated_t<F>,
+           class = enable_if_t<simd::ScanSupported<Op, T, X>{}>>
+  static X inclusive(Rank<1>, const F&, X acc, T* first, T* last) {
+    return simd::scan<Op>(T(acc), first, last - first);
+  }
+
+  /// Exclusive: each x becomes `acc`, then `acc = f(acc, x)`.
+  template<class F, class X, class It>
+  static X exclusive(Rank<0>, const F& f, X acc, It first, It last) {
+    for (; first != last; ++first) {
+      auto x = std::move(*first);
+      *first = acc;
+      InPlace<std::decay_t<F>>::update(f, acc, std::move(x));
+    }
+    return acc;
+  }
+
+  /// The inclusive scan, shifted right by one.
+  template<class F, class X, class T,
+           class = enable_if_t<simd::ScanSupported<Undecorated_t<F>, T, X>{}>>
+  static X exclusive(Rank<1>, const F& f, X acc, T* first, T* last) {
+    if (first == last) return acc;
+    X total = inclusive(Rank<1>{}, f, acc, first, last);
+    std::copy_backward(first, last - 1, last);
+    *first = acc;
+    return total;
+  }
+
+  /// The elements of contiguous containers, as pointers.
+  template<class Xs, class T = simd::Element_t<Xs>,
+           class = enable_if_t<!std::is_void<T>{}>>
+  static std::pair<T*, T*> range(Rank<1>, Xs& xs) {
+    T* first = size(xs) ? &xs[0] : nullptr;
+    return {first, first + size(xs)};
+  }
+
+  template<class Xs>
+  static auto range(Rank<0>, Xs& xs) {
+    return std::make_pair(std::begin(xs), std::end(xs));
+  }
+};
+
+struct scanl_f {
+  template<class F, class X, class Xs>
+  Xs& operator() (const F& f, X x0, Xs& xs) const {
+    auto r = scan_f::range(Rank<1>{}, xs);
+    scan_f::exclusive(Rank<1>{}, f, std::move(x0), r.first, r.second);
+    return xs;
+  }
+};
+
+struct scanl1_f {
+  template<class F, class Xs>
+  Xs& operator() (const F& f, Xs& xs) const {
+    auto r = scan_f::range(Rank<1>{}, xs);
+    if (r.first != r.second) {
+      auto x0 = *r.first;
+      scan_f::inclusive(Rank<1>{}, f, std::move(x0), ++r.first, r.second);
+    }
+    return xs;
+  }
+};
+
+struct scanr_f {
+  template<class F, class X, class Xs>
+  Xs& operator() (const F& f, X x0, Xs& xs) const {
+    scan_f::exclusive(Rank<0>{}, flip(f), std::move(x0),
+                      std::rbegin(xs), std::rend(xs));
+    return xs;
+  }
+};
+
+struct scanr1_f {
+  template<class F, class Xs>
+  Xs& operator() (const F& f, Xs& xs) const {
+    auto first = std::rbegin(xs), last = std::rend(xs);
+    if (first != last) {
+      auto x0 = *first;
+      scan_f::inclusive(Rank<0>{}, flip(f), std::move(x0), ++first, last);
+    }
+    return xs;
   }
 };
 
-constexpr auto foldl = multary(foldl_f{});
+/// scanl(f, x, xs) -- The exclusive scan, in place: each xs[i] becomes
+/// foldl(f, x, {xs[0], ..., xs[i-1]}), so xs[0] becomes `x`.
+///
+/// Ex: scanl(add, 0, {1,2,3}) = {0,1,3}
+constexpr auto scanl = multary_n<2>(scanl_f{});
+
+/// scanl1(f, xs) -- The inclusive scan, in place: each xs[i] becomes
+/// foldl(f, xs[0], {xs[1], ..., xs[i]}).
+///
+/// Ex: scanl1(add, {1,2,3}) = {1,3,6}
+constexpr auto scanl1 = multary_n<1>(scanl1_f{});
+
+/// scanr(f, x, xs) -- The exclusive scan from the right: xs[n-1] becomes
+/// `x` and each xs[i] becomes f(xs[i+1], f(..., f(xs[n-1], x))).
+///
+/// Ex: scanr(sub, 0, {1,2,3}) = {(2-(3-0)), 3-0, 0} = {-1,3,0}
+constexpr auto scanr = multary_n<2>(scanr_f{});
+
+/// scanr1(f, xs) -- The inclusive scan from the right: each xs[i] becomes
+/// f(xs[i], f(..., xs[n-1])).
+///
+/// Ex: scanr1(sub, {1,2,3}) = {1-(2-3), 2-3, 3} = {2,-1,3}
+constexpr auto scanr1 = multary_n<1>(scanr1_f{});
+
+/// Sorts random-access ranges by a projection, computing it once per element
+/// (decorate-sort-undecorate).
+struct sort_by_f {
+  template<class PF, class Xs>
+  using Key = std::decay_t<decltype(invoke(std::declval<const PF&>(),
+                                           *std::begin(std::declval<Xs&>())))>;
+
+  /// A key and the position of the element it was projected from.
+  template<class PF, class Xs>
+  using Keys = std::vector<std::pair<Key<PF, Xs>, std::size_t>>;
+
+  /// Orders by key alone.
+  struct by_key {
+    template<class K>
+    bool operator() (const K& a, const K& b) const { return a.first < b.first; }
+  };
+
+  /// Orders by key, then position, which makes any sort stable.
+  struct by_key_then_index {
+    template<class K>
+    bool operator() (const K& a, const K& b) const {
+      return a.first < b.first || (!(b.first < a.first) && a.second < b.second);
+    }
+  };
+
+  template<class PF, class Xs>
+  static Keys<PF, Xs> keys(const PF& pf, Xs& xs) {
+    auto first = std::begin(xs);
+    std::size_t n = std::distance(first, std::end(xs));
+    Keys<PF, Xs> ks;
+    ks.reserve(n);
+    for (std::size_t i = 0; i < n; i++)
+      ks.emplace_back(invoke(pf, first[i]), i);
+    return ks;
+  }
+
+  /// Moves the element at ks[i].second to position i, for each i, by
+  /// following the cycles of the permutation, so each element moves once.
+  template<class Xs, class Ks>
+  static Xs& permute(Xs& xs, Ks& ks) {
+    auto first = std::begin(xs);
+    for (std::size_t i = 0; i < ks.size(); i++) {
+      if (ks[i].second == i) continue;
+      auto x = std::move(first[i]);
+      std::size_t j = i;
+      while (ks[j].second != i) {
+        std::size_t k = ks[j].second;
+        first[j] = std::move(first[k]);
+        ks[j].second = j;
+        j = k;
+      }
+      first[j] = std::move(x);
+      ks[j].second = j;
+    }
+    return xs;
+  }
+
+  template<class PF, class Xs>
+  Xs& operator() (const PF& pf, Xs& xs) const {
+    auto ks = keys(pf, xs);
+    std::sort(std::begin(ks), std::end(ks), by_key{});
+    return permute(xs, ks);
+  }
+};
+
+struct stable_sort_by_f {
+  template<class PF, class Xs>
+  Xs& operator() (const PF& pf, Xs& xs) const {
+    auto ks = sort_by_f::keys(pf, xs);
+    std::sort(std::begin(ks), std::end(ks), sort_by_f::by_key_then_index{});
+    return sort_by_f::permute(xs, ks);
+  }
+};
+
+/// sort_by(pf, xs) <=> std::sort(begin(xs), end(xs), proj_less(pf))
+///
+/// But `pf` is called once per element, rather than twice per comparison:
+/// the keys are sorted along with their positions and `xs` is then permuted
+/// in place.
+constexpr auto sort_by = multary_n<1>(sort_by_f{});
+
+/// stable_sort_by(pf, xs) <=> std::stable_sort(begin(xs), end(xs),
+///                                             proj_less(pf))
+constexpr auto stable_sort_by = multary_n<1>(stable_sort_by_f{});
+
+/// Lazy ranges.
+///
+/// Views are functions from ranges to lazy ranges that compute their elements
+/// as they are iterated, so a chain of them runs in a single loop and never
+/// allocates. They compose with `|`, left-to-right, using mcompose:
+///
+///   auto sum_even_squares = view::map(square) | view::filter(even)
+///                         | foldl(add, 0);
+///   sum_even_squares(xs);  // one pass over xs
+///   xs | view::take(3);    // a range of the first three elements of xs
+namespace view {
+
+/// The iterator type of a range, `Xs`, held by a view.
+template<class Xs>
+using Iterator = decltype(std::begin(std::declval<const Xs&>()));
+
+/// Defines the types std::iterator_traits expects of iterators over `Ref`.
+template<class Ref>
+struct iterator_base {
+  using iterator_category = std::input_iterator_tag;
+  using value_type        = std::decay_t<Ref>;
+  using difference_type   = std::ptrdiff_t;
+  using pointer           = const value_type*;
+  using reference         = Ref;
+};
+
+/// map(f, xs) -- A range of `f(x)` for each `x` in `xs`.
+template<class Xs, class F>
+struct Map {
+  Xs xs;
+  F f;
+
+  using Ref = decltype(invoke(std::declval<const F&>(),
+                              *std::declval<Iterator<Xs>>()));
+
+  struct iterator : iterator_base<Ref> {
+    Iterator<Xs> it;
+    const F* f;
+
+    iterator(Iterator<Xs> it, const F* f) : it(std::move(it)), f(f) { }
+
+    Ref operator* () const { return invoke(*f, *it); }
+
+    iterator& operator++ () { ++it; return *this; }
+    iterator operator++ (int) { auto old = *this; ++it; return old; }
+
+    bool operator== (const iterator& o) const { return it == o.it; }
+    bool operator!= (const iterator& o) const { return it != o.it; }
+  };
+
+  iterator begin() const { return {std::begin(xs), &f}; }
+  iterator end()   const { return {std::end(xs), &f}; }
+};
+
+/// filter(p, xs) -- A range of each `x` in `xs` that satisfies `p(x)`.
+template<class Xs, class Pred>
+struct Filter {
+  Xs xs;
+  Pred p;
+
+  using Ref = decltype(*std::declval<Iterator<Xs>>());
+
+  struct iterator : iterator_base<Ref> {
+    Iterator<Xs> it, last;
+    const Pred* p;
+
+    iterator(Iterator<Xs> it, Iterator<Xs> last, const Pred* p)
+      : it(std::move(it)), last(std::move(last)), p(p)
+    {
+      skip();
+    }
+
+    /// Advances `it` to the next element satisfying `p`.
+    void skip() {
+      while (it != last && !invoke(*p, *it)) ++it;
+    }
+
+    Ref operator* () const { return *it; }
+
+    iterator& operator++ () { ++it; skip(); return *this; }
+    iterator operator++ (int) { auto old = *this; ++*this; return old; }
+
+    bool operator== (const iterator& o) const { return it == o.it; }
+    bool operator!= (const iterator& o) const { return it != o.it; }
+  };
+
+  iterator begin() const { return {std::begin(xs), std::end(xs), &p}; }
+  iterator end()   const { return {std::end(xs), std::end(xs), &p}; }
+};
+
+/// take(n, xs) -- A range of the first `n` elements of `xs`.
+template<class Xs>
+struct Take {
+  Xs xs;
+  std::size_t n;
+
+  using Ref = decltype(*std::declval<Iterator<Xs>>());
+
+  struct iterator : iterator_base<Ref> {
+    Iterator<Xs> it;
+    std::size_t n;  // The number of elements left.
+
+    iterator(Iterator<Xs> it, std::size_t n) : it(std::move(it)), n(n) { }
+
+    Ref operator* () const { return *it; }
+
+    // Don't advance past the n'th element; `xs` may be lazy.
+    iterator& operator++ () { if (--n) ++it; return *this; }
+    iterator operator++ (int) { auto old = *this; ++*this; return old; }
+
+    bool operator== (const iterator& o) const {
+      return n == o.n || it == o.it;
+    }
+    bool operator!= (const iterator& o) const { return !(*this == o); }
+  };
+
+  iterator begin() const { return {std::begin(xs), n}; }
+  iterator end()   const { return {std::end(xs), 0}; }
+};
+
+/// A function from ranges to lazy ranges.
+template<class F>
+struct View {
+  F f;
+
+  template<class Xs>
+  constexpr decltype(auto) operator() (Xs&& xs) const {
+    return invoke(f, std::forward<Xs>(xs));
+  }
+};
+
+template<class F>
+constexpr View<F> make_view(F f) { return {std::move(f)}; }
+
+template<class X>
+struct IsView : Bool<false> { };
+
+template<class F>
+struct IsView<View<F>> : Bool<true> { };
+
+/// (v | w)(xs) <=> w(v(xs))
+template<class F, class G>
+constexpr auto operator| (View<F> v, View<G> w) {
+  return make_view(mcompose(std::move(w.f), std::move(v.f)));
+}
+
+/// (v | g)(xs) <=> g(v(xs)), where `g` may consume the range, like `foldl`.
+template<class F, class G, class = enable_if_t<!IsView<std::decay_t<G>>{}>>
+constexpr auto operator| (View<F> v, G g) {
+  return mcompose(std::move(g), std::move(v));
+}
+
+/// xs | v <=> v(xs)
+template<class Xs, class F,
+         class = enable_if_t<!IsView<std::decay_t<Xs>>{}>>
+constexpr decltype(auto) operator| (Xs&& xs, const View<F>& v) {
+  return v(std::forward<Xs>(xs));
+}
+
+struct map_f {
+  template<class F, class Xs>
+  constexpr Map<Xs, F> operator() (F f, Xs&& xs) const {
+    return {std::forward<Xs>(xs), std::move(f)};
+  }
+
+  template<class F>
+  constexpr auto operator() (F f) const {
+    return make_view(closure(*this, std::move(f)));
+  }
+};
+
+struct filter_f {
+  template<class Pred, class Xs>
+  constexpr Filter<Xs, Pred> operator() (Pred p, Xs&& xs) const {
+    return {std::forward<Xs>(xs), std::move(p)};
+  }
+
+  template<class Pred>
+  constexpr auto operator() (Pred p) const {
+    return make_view(closure(*this, std::move(p)));
+  }
+};
+
+struct take_f {
+  template<class Xs>
+  constexpr Take<Xs> operator() (std::size_t n, Xs&& xs) const {
+    return {std::forward<Xs>(xs), n};
+  }
+
+  constexpr auto operator() (std::size_t n) const {
+    return make_view(closure(*this, n));
+  }
+};
+
+/// Ranges given by lvalue are referred to; rvalues are moved into the view.
+constexpr map_f map{};
+constexpr filter_f filter{};
+constexpr take_f take{};
+
+} // namespace view
 
 }
@@ -9,6 +9,51 @@ constexpr struct basic_not_f {
   constexpr bool operator() (bool b) const { return !b; }
 } basic_not{};
 
+#ifdef __cpp_fold_expressions
+namespace detail {
+
+/// An argument of a fold over logic::project or logic::transitive.
+template<class X>
+struct Arg {
+  X x;
+};
+
+/// The state of a fold of project: whether each argument so far was ok, and
+/// the last, whose predicate is yet to be checked.
+template<class Ok, class Pred, class X>
+struct Projecting {
+  const Ok& ok;
+  const Pred& p;
+  bool go;
+  X x;
+
+  template<class Y>
+  constexpr Projecting<Ok, Pred, Y> operator| (Arg<Y>&& y) && {
+    bool next = go && fu::invoke(ok, fu::invoke(p, std::forward<X>(x)));
+    return {ok, p, next, std::forward<Y>(y.x)};
+  }
+};
+
+/// The state of a fold of transitive: whether each pair so far was ok, and
+/// the last pair, whose predicate is yet to be checked.
+template<class Ok, class Pred, class X, class Y>
+struct Transiting {
+  const Ok& ok;
+  const Pred& p;
+  bool go;
+  X x;
+  Y y;
+
+  template<class Z>
+  constexpr Transiting<Ok, Pred, Y, Z> operator| (Arg<Z>&& z) && {
+    bool next = go && fu::invoke(ok, fu::invoke(p, std::forward<X>(x), y));
+    return {ok, p, next, std::forward<Y>(y), std::forward<Z>(z.x)};
+  }
+};
+
+} // namespace detail
+#endif  // __cpp_fold_expressions
+
 /// Logical function projection.
 /// Invokes short-circuit logical operations on a predicate, p.
 ///
@@ -26,10 +71,18 @@ struct project_f {
            class = enable_if_t<(sizeof...(Y) > 0)>>
   constexpr decltype(auto) operator() (Identity&& id, Ok&& ok,
                                        Pred&& p, X&& x, Y&&...y) const {
+#ifdef __cpp_fold_expressions
+    auto last = (detail::Projecting<Ok, Pred, X&&>{ok, p, true,
+                                                    std::forward<X>(x)} | ... |
+                 detail::Arg<Y&&>{std::forward<Y>(y)});
+    return last.go ? fu::invoke(p, std::forward<decltype(last.x)>(last.x))
+                   : std::forward<Identity>(id);
+#else
     return fu::invoke(ok, fu::invoke(p, std::forward<X>(x)))
       ? (*this)(std::forward<Identity>(id), std::forward<Ok>(ok),
                 std::forward<Pred>(p), std::forward<Y>(y)...)
       : std::forward<Identity>(id);
+#endif
   }
 };
 
@@ -45,11 +98,20 @@ struct transitive_f {
            class = enable_if_t<(sizeof...(Z) > 0)>>
   constexpr decltype(auto) operator() (Identity&& id, Ok&& ok,
                                        Pred&& p, X&& x, Y&& y, Z&&...z) const {
+#ifdef __cpp_fold_expressions
+    auto last = (detail::Transiting<Ok, Pred, X&&, Y&&>{
+                   ok, p, true, std::forward<X>(x), std::forward<Y>(y)} | ... |
+                 detail::Arg<Z&&>{std::forward<Z>(z)});
+    return last.go ? fu::invoke(p, std::forward<decltype(last.x)>(last.x),
+                                std::forward<decltype(last.y)>(last.y))
+                   : std::forward<Identity>(id);
+#else
     return fu::invoke(ok, fu::invoke(p, std::forward<X>(x), y))
       ? (*this)(std::forward<Identity>(id), std::forward<Ok>(ok),
                 std::forward<Pred>(p),
                 std::forward<Y>(y), std::forward<Z>(z)...)
       : std::forward<Identity>(id);
+#endif
   }
 };
 
@@ -0,0 +1,356 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fu/basic.h>
+#include <fu/meta.h>
+#include <fu/tuple.h>
+
+/// Memoization: caching the results of pure functions.
+
+namespace fu {
+
+constexpr struct hash_f {
+  template<class X>
+  std::size_t operator() (const X& x) const {
+    return std::hash<X>{}(x);
+  }
+} hash{};
+
+/// hash_combine(seed, h) -- Mixes the hash, `h`, into `seed`.
+constexpr struct hash_combine_f {
+  std::size_t operator() (std::size_t seed, std::size_t h) const {
+    return seed ^ (h + 0x9E3779B9 + (seed << 6) + (seed >> 2));
+  }
+} hash_combine{};
+
+/// Hashes tuples by combining the hashes of their elements.
+struct TupleHash {
+  template<class...X>
+  std::size_t operator() (const std::tuple<X...>& t) const {
+    return tpl::foldl(hash_combine, std::size_t(0), tpl::map(hash, t));
+  }
+
+  std::size_t operator() (const std::tuple<>&) const { return 0; }
+};
+
+/// A lock for short critical sections: unlocking is a plain store, and
+/// waiting threads yield rather than sleep.
+class SpinLock {
+  std::atomic_flag flag = ATOMIC_FLAG_INIT;
+
+public:
+  void lock() {
+    while (flag.test_and_set(std::memory_order_acquire))
+      std::this_thread::yield();
+  }
+
+  void unlock() { flag.clear(std::memory_order_release); }
+};
+
+/// A cache of memoized results, type-erased so that one memoized function may
+/// keep one per signature.
+struct CacheBase {
+  virtual ~CacheBase() = default;
+  virtual std::size_t hits() const = 0;
+  virtual std::size_t misses() const = 0;
+};
+
+/// LruCache<Key, R> -- A thread-safe, least-recently-used cache.
+///
+/// The cache is split into shards by the hash of the key, each with its own
+/// lock, so threads rarely contend. Each shard preallocates its entries and
+/// finds them through an open-addressing (linear probing) index. Recency is
+/// approximated by the CLOCK algorithm: a hit only marks its entry as used,
+/// rather than relinking a list, and eviction sweeps the entries in a circle,
+/// sparing (and unmarking) those used since the last sweep. Evicted entries'
+/// storage is reused, so a full cache never allocates.
+template<class Key, class R>
+class LruCache : public CacheBase {
+  static constexpr std::size_t shard_bits = 4;
+
+  struct Node {
+    Key key;
+    R value;
+    std::uint64_t hash;
+    bool used;
+  };
+
+  struct Shard {
+    mutable SpinLock m;
+    std::vector<Node> nodes;
+    std::vector<std::uint32_t> slots;  // One past a node's index, or zero.
+    std::size_t hand = 0;  // The next entry to consider evicting.
+    std::size_t hits = 0, misses = 0;
+
+    std::size_t home(std::uint64_t h) const {
+      return (h >> 32) & (slots.size() - 1);
+    }
+
+    std::size_t next_slot(std::size_t i) const {
+      return (i + 1) & (slots.size() - 1);
+    }
+
+    /// The slot of the node with key `k`, or of the empty slot it would go.
+    std::size_t find(std::uint64_t h, const Key& k) const {
+      std::size_t i = home(h);
+      for (; slots[i]; i = next_slot(i)) {
+        const Node& n = nodes[slots[i] - 1];
+        if (n.hash == h && n.key == k) break;
+      }
+      return i;
+    }
+
+    /// Empties slot `i`, shifting back the entries after it that would
+    /// otherwise become unreachable.
+    void erase(std::size_t i) {
+      for (std::size_t j = next_slot(i); slots[j]; j = next_slot(j)) {
+        std::size_t k = home(nodes[slots[j] - 1].hash);
+        bool between = i <= j ? i < k && k <= j : i < k || k <= j;
+        if (!between) {
+          slots[i] = slots[j];
+          i = j;
+        }
+      }
+      slots[i] = 0;
+    }
+
+    /// The next entry not used since the hand last passed it.
+    std::uint32_t victim() {
+      while (nodes[hand].used) {
+        nodes[hand].used = false;
+        hand = (hand + 1) % nodes.size();
+      }
+      std::uint32_t i = hand;
+      hand = (hand + 1) % nodes.size();
+      return i;
+    }
+  };
+
+  std::size_t shard_capacity;
+  Shard shards[1 << shard_bits];
+
+  /// Spreads the bits of the key's hash; the top bits choose the shard.
+  static std::uint64_t hash(const Key& k) {
+    return TupleHash{}(k) * 0x9E3779B97F4A7C15ull;
+  }
+
+  Shard& shard(std::uint64_t h) { return shards[h >> (64 - shard_bits)]; }
+
+  void insert(Shard& s, std::uint64_t h, const Key& k, const R& r) {
+    std::lock_guard<SpinLock> lock(s.m);
+    std::size_t slot = s.find(h, k);
+    if (s.slots[slot]) return;  // Computed by another thread meanwhile.
+
+    std::uint32_t i;
+    if (s.nodes.size() < shard_capacity) {
+      i = s.nodes.size();
+      s.nodes.push_back(Node{k, r, h, false});
+    } else {
+      i = s.victim();
+      s.erase(s.find(s.nodes[i].hash, s.nodes[i].key));
+      s.nodes[i] = Node{k, r, h, false};
+      slot = s.find(h, k);
+    }
+    s.slots[slot] = i + 1;
+  }
+
+public:
+  explicit LruCache(std::size_t capacity)
+    : shard_capacity((capacity >> shard_bits) + 1)
+  {
+    std::size_t n = 2;
+    while (n < 2 * shard_capacity) n *= 2;
+    for (Shard& s : shards) {
+      s.nodes.reserve(shard_capacity);
+      s.slots.assign(n, 0);
+    }
+  }
+
+  /// The cached result for `k`, marked as recently used, or else the
+  /// result of `compute()`, cached. The shard is not locked during
+  /// `compute()`, so it may recurse into the cache.
+  template<class G>
+  R get(const Key& k, const G& compute) {
+    std::uint64_t h = hash(k);
+    Shard& s = shard(h);
+    {
+      std::lock_guard<SpinLock> lock(s.m);
+      if (std::uint32_t i = s.slots[s.find(h, k)]) {
+        s.hits++;
+        s.nodes[i-1].used = true;
+        return s.nodes[i-1].value;
+      }
+      s.misses++;
+    }
+
+    R r = compute();
+    insert(s, h, k, r);
+    return r;
+  }
+
+  std::size_t hits() const override {
+    std::size_t n = 0;
+    for (const Shard& s : shards) {
+      std::lock_guard<SpinLock> lock(s.m);
+      n += s.hits;
+    }
+    return n;
+  }
+
+  std::size_t misses() const override {
+    std::size_t n = 0;
+    for (const Shard& s : shards) {
+      std::lock_guard<SpinLock> lock(s.m);
+      n += s.misses;
+    }
+    return n;
+  }
+};
+
+/// The caches of a memoized function, one per signature it is called with,
+/// shared by its copies.
+class MemoState {
+  static constexpr std::size_t max_signatures = 8;
+
+  template<class Cache>
+  struct Tag { static constexpr char id = 0; };
+
+  std::size_t capacity;
+  std::atomic<const void*> tags[max_signatures];
+  std::unique_ptr<CacheBase> caches[max_signatures];
+  std::mutex m;
+
+public:
+  explicit MemoState(std::size_t capacity) : capacity(capacity) {
+    for (auto& t : tags) t.store(nullptr, std::memory_order_relaxed);
+  }
+
+  /// The cache of type `Cache`, created on first use. Lookups take no lock.
+  template<class Cache>
+  Cache& get() {
+    const void* tag = &Tag<Cache>::id;
+    for (std::size_t i = 0; i < max_signatures; i++) {
+      const void* t = tags[i].load(std::memory_order_acquire);
+      if (t == tag) return static_cast<Cache&>(*caches[i]);
+      if (!t) break;
+    }
+
+    std::lock_guard<std::mutex> lock(m);
+    for (std::size_t i = 0; i < max_signatures; i++) {
+      const void* t = tags[i].load(std::memory_order_relaxed);
+      if (t == tag) return static_cast<Cache&>(*caches[i]);
+      if (!t) {
+        caches[i] = std::make_unique<Cache>(capacity);
+        tags[i].store(tag, std::memory_order_release);
+        return static_cast<Cache&>(*caches[i]);
+      }
+    }
+    throw std::length_error("fu::memo: called with too many signatures");
+  }
+
+  std::size_t hits() {
+    std::lock_guard<std::mutex> lock(m);
+    std::size_t n = 0;
+    for (auto& c : caches) n += c ? c->hits() : 0;
+    return n;
+  }
+
+  std::size_t misses() {
+    std::lock_guard<std::mutex> lock(m);
+    std::size_t n = 0;
+    for (auto& c : caches) n += c ? c->misses() : 0;
+    return n;
+  }
+};
+
+template<class Cache>
+constexpr char MemoState::Tag<Cache>::id;
+
+/// Memo<F, Fix> -- `f`, memoized. If Fix, `f` is called as by fix: with
+/// itself, memoized, as its first argument.
+template<class F, bool Fix>
+class Memo {
+  F f;
+  std::shared_ptr<MemoState> state;
+
+  template<class...X>
+  decltype(auto) call(Bool<false>, X&&...x) const {
+    return invoke(f, std::forward<X>(x)...);
+  }
+
+  template<class...X>
+  decltype(auto) call(Bool<true>, X&&...x) const {
+    return invoke(f, *this, std::forward<X>(x)...);
+  }
+
+public:
+  Memo(F f, std::size_t capacity)
+    : f(std::move(f)), state(std::make_shared<MemoState>(capacity))
+  {
+  }
+
+  template<class...X,
+           class R = std::decay_t<decltype(std::declval<const Memo&>()
+                                             .call(Bool<Fix>{},
+                                                   std::declval<X>()...))>>
+  R operator() (X&&...x) const {
+    using Key = std::tuple<std::decay_t<X>...>;
+    auto& cache = state->get<LruCache<Key, R>>();
+
+    return cache.get(Key(x...), [&] {
+      return call(Bool<Fix>{}, std::forward<X>(x)...);
+    });
+  }
+
+  /// The number of calls answered from, and not found in, the cache.
+  std::size_t hits() const { return state->hits(); }
+  std::size_t misses() const { return state->misses(); }
+};
+
+struct memo_f {
+  template<class F>
+  Memo<F, false> operator() (F f, std::size_t capacity) const {
+    return {std::move(f), capacity};
+  }
+};
+
+struct memo_fix_f {
+  template<class F>
+  Memo<F, true> operator() (F f, std::size_t capacity) const {
+    return {std::move(f), capacity};
+  }
+};
+
+/// memo(f, n) -- `f`, caching the results of its last `n` or so distinct
+/// calls. `f` must be pure and its arguments hashable. Results are keyed by
+/// the decayed types of the arguments, so a string literal is keyed by its
+/// address, not its contents.
+///
+/// The cache is shared between copies and is thread-safe. `hits()` and
+/// `misses()` count the calls answered from the cache and not.
+///
+/// Ex:
+///   auto parse = fu::memo(parse_date, 1024);
+constexpr auto memo = multary(memo_f{});
+
+/// memo_fix(f, n) <=> fix(f), but memoized, including recursive calls.
+///
+/// Ex:
+///   auto fib = fu::memo_fix([](auto rec, long n) -> long {
+///     return n < 2 ? n : rec(n-1) + rec(n-2);
+///   }, 128);
+constexpr auto memo_fix = multary(memo_fix_f{});
+
+} // namespace fu
@@ -21,13 +21,12 @@ template<std::size_t x>  using Size  = Integral<std::size_t, x>;
 namespace meta {
 
 namespace detail {
-  template<bool...>  struct all;
-  template<bool...b> struct all<true, b...> : all<b...>  { };
-  template<>         struct all<true>       : Bool<true> { };
-  template<>         struct all<>           : Bool<true> { };
+  template<bool...> struct bools;
 }
 
-template<bool...b> using all = detail::all<b...>;
+/// Whether every `b` is true, in one instantiation, however many there are.
+template<bool...b>
+using all = std::is_same<detail::bools<b..., true>, detail::bools<true, b...>>;
 
 template<template<class...>class F, class...X>
 using Apply = F<X...>;
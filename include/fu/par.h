@@ -0,0 +1,425 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <fu/list.h>
+#include <fu/utility.h>
+
+/// Parallel versions of the algorithms in "fu/list.h".
+
+namespace fu {
+namespace par {
+
+/// The number of threads parallel algorithms split their work between.
+/// Defaults to the hardware concurrency, but may be assigned to.
+inline std::size_t& concurrency() {
+  static std::size_t n = std::max(1u, std::thread::hardware_concurrency());
+  return n;
+}
+
+/// The fewest elements worth giving a thread of their own.
+constexpr std::size_t min_grain = 1 << 14;
+
+template<class Xs>
+using Iterator = decltype(std::begin(std::declval<Xs&>()));
+
+template<class Xs>
+using IsRandomAccess =
+  std::is_base_of<std::random_access_iterator_tag,
+                  typename std::iterator_traits<Iterator<Xs>>::iterator_category>;
+
+/// Invokes f(i) for each i in [0, n), each on its own thread; f(0) runs on
+/// the calling thread. Returns {f(0), ..., f(n-1)}.
+template<class F, class R = std::result_of_t<const F&(std::size_t)>>
+std::vector<R> run_n(std::size_t n, const F& f) {
+  std::vector<std::future<R>> futures;
+  futures.reserve(n - 1);
+  for (std::size_t i = 1; i < n; i++)
+    futures.push_back(std::async(std::launch::async, std::cref(f), i));
+
+  std::vector<R> rs;
+  rs.reserve(n);
+  rs.push_back(f(0));
+  for (auto& fut : futures) rs.push_back(fut.get());
+  return rs;
+}
+
+/// A span of indices, [first, last), owned by one worker of for_each_batch
+/// and stolen from by the others.
+struct Span {
+  std::mutex m;
+  std::size_t first = 0, last = 0;
+
+  /// Takes up to `grain` indices from the front into [lo, hi).
+  bool take(std::size_t grain, std::size_t& lo, std::size_t& hi) {
+    std::lock_guard<std::mutex> lock(m);
+    if (first == last) return false;
+    lo = first;
+    hi = first = first + std::min(grain, last - first);
+    return true;
+  }
+
+  /// Moves the back half of `victim` into this, which must be empty.
+  bool steal(Span& victim) {
+    std::size_t lo, hi;
+    {
+      std::lock_guard<std::mutex> lock(victim.m);
+      if (victim.first == victim.last) return false;
+      lo = victim.first + (victim.last - victim.first) / 2;
+      hi = victim.last;
+      victim.last = lo;
+    }
+    std::lock_guard<std::mutex> lock(m);
+    first = lo;
+    last = hi;
+    return true;
+  }
+};
+
+/// How long a batch of for_each_batch should take to run.
+constexpr std::chrono::microseconds target_batch_time{50};
+
+/// Invokes f(lo, hi) on batches of indices that cover [0, n) exactly once,
+/// across concurrency() threads.
+///
+/// Each thread starts out owning an equal span of the indices and takes
+/// batches from its front. Once it runs out, it steals the back half of
+/// another thread's span, so uneven costs balance out. Batch sizes (the grain)
+/// adapt to the cost of `f`: each thread doubles its grain while batches run
+/// faster than target_batch_time and halves it when they run much slower, so
+/// that cheap functions are not swamped by scheduling.
+template<class F>
+void for_each_batch(std::size_t n, const F& f) {
+  std::size_t k = std::min(concurrency(), n);
+  if (k < 2) {
+    if (n) f(std::size_t(0), n);
+    return;
+  }
+
+  std::vector<Span> spans(k);
+  for (std::size_t i = 0; i < k; i++) {
+    spans[i].first = n * i / k;
+    spans[i].last = n * (i+1) / k;
+  }
+
+  run_n(k, [&](std::size_t self) {
+    using clock = std::chrono::steady_clock;
+    std::size_t grain = 1, lo, hi, done = 0;
+
+    auto next = [&] {
+      if (spans[self].take(grain, lo, hi)) return true;
+      for (std::size_t i = 1; i < k; i++) {
+        if (spans[self].steal(spans[(self + i) % k]) &&
+            spans[self].take(grain, lo, hi))
+          return true;
+      }
+      return false;
+    };
+
+    while (next()) {
+      auto start = clock::now();
+      f(lo, hi);
+      auto elapsed = clock::now() - start;
+      done += hi - lo;
+
+      if (elapsed < target_batch_time) grain *= 2;
+      else if (elapsed > 4 * target_batch_time && grain > 1) grain /= 2;
+    }
+    return done;
+  });
+}
+
+struct transform_f {
+  /// Sequential fallback: `xs` is not random-access.
+  template<class F, class Xs>
+  static Xs& map(Bool<false>, const F& f, Xs& xs) {
+    return fu::transform(f, xs);
+  }
+
+  template<class F, class Xs>
+  static Xs& map(Bool<true>, const F& f, Xs& xs) {
+    auto first = std::begin(xs);
+    for_each_batch(std::distance(first, std::end(xs)),
+                   [&](std::size_t lo, std::size_t hi) {
+                     for (auto it = first + lo; it != first + hi; ++it)
+                       *it = f(*it);
+                   });
+    return xs;
+  }
+
+  template<class F, class Xs>
+  Xs& operator() (const F& f, Xs& xs) const {
+    return map(IsRandomAccess<Xs>{}, f, xs);
+  }
+};
+
+/// par::transform(f, xs) <=> transform(f, xs)
+///
+/// Applies `f` in parallel if `xs` is random-access, balancing the work
+/// between threads by work-stealing (see for_each_batch).
+constexpr auto transform = multary(transform_f{});
+
+struct foldl_f {
+  /// Reduces the non-empty range, [first, last), from left to right.
+  template<class X, class F, class It>
+  static X reduce(const F& f, It first, It last) {
+    X acc = *first;
+    while (++first != last) InPlace<std::decay_t<F>>::update(f, acc, *first);
+    return acc;
+  }
+
+  /// Sequential fallback: `f` is not associative or `xs` is not random-access.
+  template<class F, class X, class Xs>
+  static X fold(Bool<false>, const F& f, X x0, Xs&& xs) {
+    return fu::foldl(f, std::move(x0), std::forward<Xs>(xs));
+  }
+
+  /// Splits `xs` into one chunk per thread, reduces each, and combines the
+  /// partial results as a balanced tree.
+  template<class F, class X, class Xs>
+  static X fold(Bool<true>, const F& f, X x0, Xs&& xs) {
+    auto first = std::begin(xs);
+    std::size_t n = std::distance(first, std::end(xs));
+    std::size_t chunks = std::min(concurrency(), n / min_grain);
+    if (chunks < 2)
+      return fold(Bool<false>{}, f, std::move(x0), std::forward<Xs>(xs));
+
+    std::vector<X> partials = run_n(chunks, [&](std::size_t i) {
+      return reduce<X>(f, first + n * i / chunks, first + n * (i+1) / chunks);
+    });
+
+    for (std::size_t stride = 1; stride < chunks; stride *= 2) {
+      for (std::size_t i = 0; i + stride < chunks; i += 2 * stride) {
+        partials[i] = invoke(f, std::move(partials[i]),
+                             std::move(partials[i + stride]));
+      }
+    }
+    return invoke(f, std::move(x0), std::move(partials[0]));
+  }
+
+  template<class F, class X, class Xs>
+  X operator() (const F& f, X x0, Xs&& xs) const {
+    using Parallel = Bool<Associative<std::decay_t<F>>::value &&
+                          IsRandomAccess<Xs>::value>;
+    return fold(Parallel{}, f, std::move(x0), std::forward<Xs>(xs));
+  }
+
+  /// Sums the same blocks as the sequential foldl, but across threads, and
+  /// combines them in the same order so that the results are identical.
+  template<class X, class Xs, class = enable_if_t<IsRandomAccess<Xs>{}>>
+  X operator() (const compensated_add_f& f, X x0, Xs&& xs) const {
+    using C = compensated_add_f;
+    auto first = std::begin(xs);
+    std::size_t n = std::distance(first, std::end(xs));
+    if (n < min_grain) return fu::foldl(f, x0, std::forward<Xs>(xs));
+
+    std::vector<Compensated<X>> blocks((n + C::block_size - 1) / C::block_size);
+    for_each_batch(blocks.size(), [&](std::size_t lo, std::size_t hi) {
+      for (std::size_t b = lo; b < hi; b++) {
+        auto it = first + b * C::block_size;
+        auto last = first + std::min(n, (b+1) * C::block_size);
+        blocks[b] = C::block<X>(it, last);
+      }
+    });
+    return C::total(x0, blocks);
+  }
+};
+
+/// par::foldl(f, x, xs) <=> foldl(f, x, xs)
+///
+/// Folds in parallel when `f` is declared Associative and `xs` is
+/// random-access, otherwise sequentially.
+constexpr auto foldl = multary_n<2>(foldl_f{});
+
+struct scan_f {
+  /// Scans the random-access range, [first, last), in two passes over
+  /// chunks, one per thread: the first reduces each chunk, and the second
+  /// scans each starting from the fold of the chunks before it.
+  template<class F, class X, class It, class Scan>
+  static void two_pass(const F& f, X x0, It first, It last, const Scan& step)
+  {
+    std::size_t n = std::distance(first, last);
+    std::size_t chunks = std::min(concurrency(), n / min_grain);
+    if (chunks < 2) {
+      step(f, std::move(x0), first, last);
+      return;
+    }
+
+    auto chunk = [&](std::size_t i) { return first + n * i / chunks; };
+
+    std::vector<X> seeds = run_n(chunks - 1, [&](std::size_t i) {
+      return foldl_f::reduce<X>(f, chunk(i), chunk(i+1));
+    });
+    seeds.insert(std::begin(seeds), std::move(x0));
+    for (std::size_t i = 1; i < chunks; i++)
+      seeds[i] = invoke(f, seeds[i-1], std::move(seeds[i]));
+
+    run_n(chunks, [&](std::size_t i) {
+      return step(f, seeds[i], chunk(i), chunk(i+1));
+    });
+  }
+
+  /// Scans sequentially: `f` is not associative or `xs` is not
+  /// random-access.
+  template<class F, class X, class It, class Scan>
+  static void scan(Bool<false>, const F& f, X x0, It first, It last,
+                   const Scan& step)
+  {
+    step(f, std::move(x0), first, last);
+  }
+
+  template<class F, class X, class It, class Scan>
+  static void scan(Bool<true>, const F& f, X x0, It first, It last,
+                   const Scan& step)
+  {
+    two_pass(f, std::move(x0), first, last, step);
+  }
+
+  template<class P, class F, class X, class It>
+  static void exclusive(P, const F& f, X x0, It first, It last) {
+    scan(P{}, f, std::move(x0), first, last, [](auto&&...args) {
+      return fu::scan_f::exclusive(Rank<1>{}, args...);
+    });
+  }
+
+  template<class P, class F, class It>
+  static void inclusive(P, const F& f, It first, It last) {
+    if (first == last) return;
+    auto x0 = *first;
+    scan(P{}, f, std::move(x0), ++first, last, [](auto&&...args) {
+      return fu::scan_f::inclusive(Rank<1>{}, args...);
+    });
+  }
+
+  template<class F, class Xs>
+  using Parallel = Bool<Associative<std::decay_t<F>>::value &&
+                        IsRandomAccess<Xs>::value>;
+};
+
+struct scanl_f {
+  template<class F, class X, class Xs>
+  Xs& operator() (const F& f, X x0, Xs& xs) const {
+    auto r = fu::scan_f::range(Rank<1>{}, xs);
+    scan_f::exclusive(scan_f::Parallel<F, Xs>{}, f, std::move(x0),
+                      r.first, r.second);
+    return xs;
+  }
+};
+
+struct scanl1_f {
+  template<class F, class Xs>
+  Xs& operator() (const F& f, Xs& xs) const {
+    auto r = fu::scan_f::range(Rank<1>{}, xs);
+    scan_f::inclusive(scan_f::Parallel<F, Xs>{}, f, r.first, r.second);
+    return xs;
+  }
+};
+
+struct scanr_f {
+  template<class F, class X, class Xs>
+  Xs& operator() (const F& f, X x0, Xs& xs) const {
+    scan_f::exclusive(scan_f::Parallel<F, Xs>{}, flip(f), std::move(x0),
+                      std::rbegin(xs), std::rend(xs));
+    return xs;
+  }
+};
+
+struct scanr1_f {
+  template<class F, class Xs>
+  Xs& operator() (const F& f, Xs& xs) const {
+    scan_f::inclusive(scan_f::Parallel<F, Xs>{}, flip(f),
+                      std::rbegin(xs), std::rend(xs));
+    return xs;
+  }
+};
+
+/// par::scanl(f, x, xs) <=> scanl(f, x, xs), and likewise for scanl1, scanr
+/// and scanr1.
+///
+/// Scans in parallel when `f` is declared Associative and `xs` is
+/// random-access, otherwise sequentially. Floating-point results may differ
+/// from the sequential scan's by rounding, since the partial results are
+/// grouped differently.
+constexpr auto scanl = multary_n<2>(scanl_f{});
+constexpr auto scanl1 = multary_n<1>(scanl1_f{});
+constexpr auto scanr = multary_n<2>(scanr_f{});
+constexpr auto scanr1 = multary_n<1>(scanr1_f{});
+
+/// Sorts [first, last) with `less` across threads: each sorts one chunk,
+/// then neighbouring chunks are merged in parallel, doubling in size.
+template<class It, class Less>
+void sort(It first, It last, const Less& less) {
+  std::size_t n = std::distance(first, last);
+  std::size_t chunks = std::min(concurrency(), n / min_grain);
+  if (chunks < 2) {
+    std::sort(first, last, less);
+    return;
+  }
+
+  auto chunk = [&](std::size_t i) {
+    return first + n * std::min(i, chunks) / chunks;
+  };
+
+  run_n(chunks, [&](std::size_t i) {
+    std::sort(chunk(i), chunk(i+1), less);
+    return 0;
+  });
+
+  for (std::size_t width = 1; width < chunks; width *= 2) {
+    run_n((chunks + 2 * width - 1) / (2 * width), [&](std::size_t i) {
+      std::size_t lo = 2 * width * i;
+      std::inplace_merge(chunk(lo), chunk(lo + width), chunk(lo + 2 * width),
+                         less);
+      return 0;
+    });
+  }
+}
+
+struct sort_by_f {
+  /// Projects the keys across threads.
+  template<class PF, class Xs>
+  static fu::sort_by_f::Keys<PF, Xs> keys(const PF& pf, Xs& xs) {
+    auto first = std::begin(xs);
+    std::size_t n = std::distance(first, std::end(xs));
+    fu::sort_by_f::Keys<PF, Xs> ks(n);
+    for_each_batch(n, [&](std::size_t lo, std::size_t hi) {
+      for (std::size_t i = lo; i < hi; i++)
+        ks[i] = {invoke(pf, first[i]), i};
+    });
+    return ks;
+  }
+
+  template<class PF, class Xs>
+  Xs& operator() (const PF& pf, Xs& xs) const {
+    auto ks = keys(pf, xs);
+    par::sort(std::begin(ks), std::end(ks), fu::sort_by_f::by_key{});
+    return fu::sort_by_f::permute(xs, ks);
+  }
+};
+
+struct stable_sort_by_f {
+  template<class PF, class Xs>
+  Xs& operator() (const PF& pf, Xs& xs) const {
+    auto ks = sort_by_f::keys(pf, xs);
+    par::sort(std::begin(ks), std::end(ks),
+              fu::sort_by_f::by_key_then_index{});
+    return fu::sort_by_f::permute(xs, ks);
+  }
+};
+
+/// par::sort_by(pf, xs)        <=> sort_by(pf, xs)
+/// par::stable_sort_by(pf, xs) <=> stable_sort_by(pf, xs)
+///
+/// Projects the keys, and sorts them, across threads. The final permutation
+/// of `xs` is sequential.
+constexpr auto sort_by = multary_n<1>(sort_by_f{});
+constexpr auto stable_sort_by = multary_n<1>(stable_sort_by_f{});
+
+} // namespace par
+} // namespace fu
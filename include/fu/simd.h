@@ -0,0 +1,301 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#if defined(__SSE2__)
+# include <immintrin.h>
+#endif
+
+#include <fu/functional.h>
+#include <fu/utility.h>
+
+/// Explicit vector kernels for applying fu's arithmetic operators over
+/// contiguous arithmetic elements. The widest instruction set enabled at
+/// compile time (AVX-512, AVX2 or SSE2) is used.
+
+namespace fu {
+namespace simd {
+
+/// Lane<T> -- The fixed-width type a vector kernel treats T as, or void.
+///
+/// Integers of the same size share kernels since +, -, * and the bitwise
+/// operations produce the same bits whether signed or not.
+template<class T, class = void>
+struct Lane { using type = void; };
+
+template<class T>
+struct Lane<T, enable_if_t<std::is_integral<T>{} && sizeof(T) == 4>>
+{ using type = std::int32_t; };
+
+template<class T>
+struct Lane<T, enable_if_t<std::is_integral<T>{} && sizeof(T) == 8>>
+{ using type = std::int64_t; };
+
+template<> struct Lane<float>  { using type = float; };
+template<> struct Lane<double> { using type = double; };
+
+template<class T>
+using Lane_t = typename Lane<T>::type;
+
+/// Vec<L> -- Unaligned loads, stores, and broadcasts of the lane type, L.
+template<class L>
+struct Vec;
+
+/// Kernel<Op, L> -- Op applied to vectors of L. Undefined when the
+/// instruction set has no suitable instruction.
+template<class Op, class L>
+struct Kernel;
+
+#if defined(__AVX512F__)
+# define FU_MM(name) _mm512_##name
+# define FU_SI(name) _mm512_##name##_si512
+# define FU_SET1_EPI64 _mm512_set1_epi64
+using ivec = __m512i;
+using fvec = __m512;
+using dvec = __m512d;
+#elif defined(__AVX2__)
+# define FU_MM(name) _mm256_##name
+# define FU_SI(name) _mm256_##name##_si256
+# define FU_SET1_EPI64 _mm256_set1_epi64x
+using ivec = __m256i;
+using fvec = __m256;
+using dvec = __m256d;
+#elif defined(__SSE2__)
+# define FU_MM(name) _mm_##name
+# define FU_SI(name) _mm_##name##_si128
+# define FU_SET1_EPI64 _mm_set1_epi64x
+using ivec = __m128i;
+using fvec = __m128;
+using dvec = __m128d;
+#endif
+
+#ifdef FU_MM
+
+template<>
+struct Vec<std::int32_t> {
+  using type = ivec;
+  static type load(const void* p) { return FU_SI(loadu)((const ivec*)p); }
+  static void store(void* p, type v) { FU_SI(storeu)((ivec*)p, v); }
+  static type set1(std::int32_t x) { return FU_MM(set1_epi32)(x); }
+};
+
+template<>
+struct Vec<std::int64_t> {
+  using type = ivec;
+  static type load(const void* p) { return FU_SI(loadu)((const ivec*)p); }
+  static void store(void* p, type v) { FU_SI(storeu)((ivec*)p, v); }
+  static type set1(std::int64_t x) { return FU_SET1_EPI64(x); }
+};
+
+template<>
+struct Vec<float> {
+  using type = fvec;
+  static type load(const void* p) { return FU_MM(loadu_ps)((const float*)p); }
+  static void store(void* p, type v) { FU_MM(storeu_ps)((float*)p, v); }
+  static type set1(float x) { return FU_MM(set1_ps)(x); }
+};
+
+template<>
+struct Vec<double> {
+  using type = dvec;
+  static type load(const void* p) { return FU_MM(loadu_pd)((const double*)p); }
+  static void store(void* p, type v) { FU_MM(storeu_pd)((double*)p, v); }
+  static type set1(double x) { return FU_MM(set1_pd)(x); }
+};
+
+// Helper to define a kernel in terms of a single intrinsic.
+#define DECL_KERNEL(op, lane, intrin)                                     \
+  template<> struct Kernel<op##_f, lane> {                                \
+    using V = Vec<lane>::type;                                            \
+    static V apply(V x, V y) { return intrin(x, y); }                     \
+  };
+
+DECL_KERNEL(add,     std::int32_t, FU_MM(add_epi32));
+DECL_KERNEL(sub,     std::int32_t, FU_MM(sub_epi32));
+DECL_KERNEL(bit_and, std::int32_t, FU_SI(and));
+DECL_KERNEL(bit_or,  std::int32_t, FU_SI(or));
+DECL_KERNEL(xor_,    std::int32_t, FU_SI(xor));
+
+DECL_KERNEL(add,     std::int64_t, FU_MM(add_epi64));
+DECL_KERNEL(sub,     std::int64_t, FU_MM(sub_epi64));
+DECL_KERNEL(bit_and, std::int64_t, FU_SI(and));
+DECL_KERNEL(bit_or,  std::int64_t, FU_SI(or));
+DECL_KERNEL(xor_,    std::int64_t, FU_SI(xor));
+
+// 32-bit multiplication requires SSE4.1 (implied by AVX2), 64-bit AVX-512DQ.
+#if defined(__SSE4_1__)
+DECL_KERNEL(mult,    std::int32_t, FU_MM(mullo_epi32));
+#endif
+#if defined(__AVX512DQ__)
+DECL_KERNEL(mult,    std::int64_t, FU_MM(mullo_epi64));
+#endif
+
+DECL_KERNEL(add,     float,  FU_MM(add_ps));
+DECL_KERNEL(sub,     float,  FU_MM(sub_ps));
+DECL_KERNEL(mult,    float,  FU_MM(mul_ps));
+DECL_KERNEL(div,     float,  FU_MM(div_ps));
+
+DECL_KERNEL(add,     double, FU_MM(add_pd));
+DECL_KERNEL(sub,     double, FU_MM(sub_pd));
+DECL_KERNEL(mult,    double, FU_MM(mul_pd));
+DECL_KERNEL(div,     double, FU_MM(div_pd));
+
+#undef DECL_KERNEL
+#undef FU_MM
+#undef FU_SI
+#undef FU_SET1_EPI64
+
+#endif  // FU_MM
+
+/// Element<Xs> -- The element type of a contiguous container, or void.
+template<class Xs>
+struct Element { using type = void; };
+
+template<class T, class A>
+struct Element<std::vector<T, A>> { using type = T; };
+
+template<class T, std::size_t N>
+struct Element<std::array<T, N>> { using type = T; };
+
+template<class T, std::size_t N>
+struct Element<T[N]> { using type = T; };
+
+template<class Xs>
+using Element_t =
+  typename Element<std::remove_cv_t<std::remove_reference_t<Xs>>>::type;
+
+template<class Op, class L, class = void>
+struct HasKernel : Bool<false> { };
+
+template<class Op, class L>
+struct HasKernel<Op, L, decltype(void(&Kernel<Op, L>::apply))> : Bool<true> { };
+
+/// Whether `x = op(k, x)` over elements of type T may use a vector kernel:
+/// one must exist, and `op` must compute in T, not a wider type.
+template<class Op, class T, class K, class = void>
+struct Supported : Bool<false> { };
+
+template<class Op, class T, class K>
+struct Supported<Op, T, K,
+                 enable_if_t<std::is_arithmetic<T>{} &&
+                             std::is_same<std::common_type_t<K, T>, T>{}>>
+  : HasKernel<Op, Lane_t<T>>
+{ };
+
+/// Computes `xs[i] = op(k, xs[i])` for each i in [0, n).
+template<class Op, class T>
+void transform(T k, T* xs, std::size_t n) {
+  using L = Lane_t<T>;
+  using V = Vec<L>;
+  constexpr std::size_t lanes = sizeof(typename V::type) / sizeof(T);
+
+  auto vk = V::set1(L(k));
+  std::size_t i = 0, vn = n - n % lanes;
+  for (; i < vn; i += lanes)
+    V::store(xs + i, Kernel<Op, L>::apply(vk, V::load(xs + i)));
+  for (; i < n; i++)
+    xs[i] = Op{}(k, xs[i]);
+}
+
+/// ScanOp<Op, L> -- Op applied to 128-bit vectors of L, for scan. Defined
+/// only for operations whose identity is zero, so that shifting zeros into a
+/// vector leaves the prefix unchanged.
+template<class Op, class L>
+struct ScanOp;
+
+/// Prefix<L> -- The in-register inclusive scan of a 128-bit vector of L, in
+/// log2(lanes) shift-and-combine steps, and the broadcast of its last lane.
+template<class L>
+struct Prefix;
+
+template<class Op, class L, class = void>
+struct HasScanOp : Bool<false> { };
+
+template<class Op, class L>
+struct HasScanOp<Op, L, decltype(void(&ScanOp<Op, L>::apply))> : Bool<true> { };
+
+/// Whether `acc = op(acc, x)` over elements of type T, starting from a K, may
+/// be scanned in registers.
+template<class Op, class T, class K, class = void>
+struct ScanSupported : Bool<false> { };
+
+template<class Op, class T, class K>
+struct ScanSupported<Op, T, K,
+                     enable_if_t<std::is_integral<T>{} &&
+                                 std::is_same<std::common_type_t<K, T>, T>{}>>
+  : HasScanOp<Op, Lane_t<T>>
+{ };
+
+/// Replaces each xs[i], for i in [0, n), with `acc = op(acc, xs[i])`, where
+/// `acc` starts as `k`. Returns the final `acc`.
+template<class Op, class T>
+T scan(T k, T* xs, std::size_t n);
+
+#if defined(__SSE2__)
+
+#define DECL_SCAN_OP(op, lane, intrin)                                    \
+  template<> struct ScanOp<op##_f, lane> {                                \
+    static __m128i apply(__m128i x, __m128i y) { return intrin(x, y); }   \
+  };
+
+DECL_SCAN_OP(add,    std::int32_t, _mm_add_epi32);
+DECL_SCAN_OP(bit_or, std::int32_t, _mm_or_si128);
+DECL_SCAN_OP(xor_,   std::int32_t, _mm_xor_si128);
+
+DECL_SCAN_OP(add,    std::int64_t, _mm_add_epi64);
+DECL_SCAN_OP(bit_or, std::int64_t, _mm_or_si128);
+DECL_SCAN_OP(xor_,   std::int64_t, _mm_xor_si128);
+
+#undef DECL_SCAN_OP
+
+template<>
+struct Prefix<std::int32_t> {
+  static __m128i set1(std::int32_t x) { return _mm_set1_epi32(x); }
+
+  template<class S>
+  static __m128i scan(__m128i v) {
+    v = S::apply(v, _mm_slli_si128(v, 4));
+    return S::apply(v, _mm_slli_si128(v, 8));
+  }
+
+  static __m128i last(__m128i v) { return _mm_shuffle_epi32(v, 0xFF); }
+};
+
+template<>
+struct Prefix<std::int64_t> {
+  static __m128i set1(std::int64_t x) { return _mm_set1_epi64x(x); }
+
+  template<class S>
+  static __m128i scan(__m128i v) { return S::apply(v, _mm_slli_si128(v, 8)); }
+
+  static __m128i last(__m128i v) { return _mm_shuffle_epi32(v, 0xEE); }
+};
+
+template<class Op, class T>
+T scan(T k, T* xs, std::size_t n) {
+  using L = Lane_t<T>;
+  using P = Prefix<L>;
+  using S = ScanOp<Op, L>;
+  constexpr std::size_t lanes = sizeof(__m128i) / sizeof(T);
+
+  auto carry = P::set1(L(k));
+  std::size_t i = 0, vn = n - n % lanes;
+  for (; i < vn; i += lanes) {
+    auto v = S::apply(P::template scan<S>(_mm_loadu_si128((__m128i*)(xs + i))),
+                      carry);
+    _mm_storeu_si128((__m128i*)(xs + i), v);
+    carry = P::last(v);
+  }
+
+  T acc = vn ? xs[vn - 1] : k;
+  for (; i < n; i++) xs[i] = acc = Op{}(acc, xs[i]);
+  return acc;
+}
+
+#endif  // __SSE2__
+
+} // namespace simd
+} // namespace fu
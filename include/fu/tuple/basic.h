@@ -29,11 +29,51 @@ constexpr struct apply_f {
     return (*this)(IS{}, std::forward<F>(f), std::forward<Tuple>(t));
   }
 
+  /// The concatenation of tuples of sizes S...: Its k'th element is element
+  /// elem(k) of tuple tuple(k).
+  template<std::size_t...S>
+  struct Flat {
+    static constexpr std::size_t size() {
+      const std::size_t sizes[] = {S..., 0};
+      std::size_t n = 0;
+      for (std::size_t s : sizes) n += s;
+      return n;
+    }
+
+    static constexpr std::size_t tuple(std::size_t k) {
+      const std::size_t sizes[] = {S..., 0};
+      std::size_t i = 0;
+      while (k >= sizes[i]) k -= sizes[i++];
+      return i;
+    }
+
+    static constexpr std::size_t elem(std::size_t k) {
+      const std::size_t sizes[] = {S..., 0};
+      std::size_t i = 0;
+      while (k >= sizes[i]) k -= sizes[i++];
+      return k;
+    }
+  };
+
+  template<std::size_t...k, class Flat, class F, class Tuples>
+  static constexpr decltype(auto) apply_flat(std::index_sequence<k...>, Flat,
+                                             F&& f, Tuples&& ts)
+  {
+    return fu::invoke(std::forward<F>(f),
+                      std::get<Flat::elem(k)>(
+                          std::get<Flat::tuple(k)>(std::forward<Tuples>(ts)))...);
+  }
+
+  /// apply(f, {x...}, {y...}, ...) = f(x..., y..., ...)
+  ///
+  /// Forwards each element straight from its tuple, so none are copied.
   template<class F, class...Tuple>
-  constexpr auto operator() (F&& f, Tuple&&...t) const
+  constexpr decltype(auto) operator() (F&& f, Tuple&&...t) const
   {
-    // TODO: don't use temporary tuple
-    return invoke1(std::forward<F>(f), std::tuple_cat(std::forward<Tuple>(t)...));
+    using Sizes = Flat<std::tuple_size<std::decay_t<Tuple>>::value...>;
+    return apply_flat(std::make_index_sequence<Sizes::size()>{}, Sizes{},
+                      std::forward<F>(f),
+                      std::forward_as_tuple(std::forward<Tuple>(t)...));
   }
 
   // Since apply_f is used to define generic partial application, it must
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace fu {
+namespace tpl {
+
+/// Tags the constructors that take the elements of a Compressed, so that they
+/// are never mistaken for copy constructors.
+struct FromElems { };
+
+/// Leaf<Owner, i, X> -- The i'th element of the Compressed, Owner, of type X.
+///
+/// Naming the owner keeps a Compressed's leaves distinct from those of any
+/// Compressed it holds, like a nested closure, so they are never ambiguous.
+template<class Owner, std::size_t i, class X,
+         bool = std::is_empty<X>::value && !std::is_final<X>::value>
+struct Leaf {
+  X x;
+
+  template<class Y>
+  constexpr Leaf(FromElems, Y&& y) : x(std::forward<Y>(y)) { }
+
+  constexpr const X& get() const & { return x; }
+  constexpr X& get() & { return x; }
+  constexpr X&& get() && { return std::forward<X>(x); }
+};
+
+/// An empty element is a base, rather than a member, so it takes no space.
+template<class Owner, std::size_t i, class X>
+struct Leaf<Owner, i, X, true> : X {
+  template<class Y>
+  constexpr Leaf(FromElems, Y&& y) : X(std::forward<Y>(y)) { }
+
+  constexpr const X& get() const & { return *this; }
+  constexpr X& get() & { return *this; }
+  constexpr X&& get() && { return std::move(*this); }
+};
+
+template<class Is, class...X>
+struct CompressedImpl;
+
+template<std::size_t...i, class...X>
+struct CompressedImpl<std::index_sequence<i...>, X...>
+  : Leaf<CompressedImpl<std::index_sequence<i...>, X...>, i, X>...
+{
+  template<class...Y>
+  constexpr CompressedImpl(FromElems e, Y&&...y)
+    : Leaf<CompressedImpl, i, X>(e, std::forward<Y>(y))...
+  {
+  }
+
+  // Finds the leaf of index j by conversion to its base, which takes one
+  // instantiation, however many elements there are.
+  template<std::size_t j, class Y, bool e>
+  static constexpr const Leaf<CompressedImpl, j, Y, e>&
+  leaf(const Leaf<CompressedImpl, j, Y, e>& l) {
+    return l;
+  }
+
+  template<std::size_t j, class Y, bool e>
+  static constexpr Leaf<CompressedImpl, j, Y, e>&
+  leaf(Leaf<CompressedImpl, j, Y, e>& l) {
+    return l;
+  }
+
+  template<std::size_t j>
+  constexpr decltype(auto) get() const & { return leaf<j>(*this).get(); }
+
+  template<std::size_t j>
+  constexpr decltype(auto) get() & { return leaf<j>(*this).get(); }
+
+  template<std::size_t j>
+  constexpr decltype(auto) get() && {
+    return std::move(leaf<j>(*this)).get();
+  }
+};
+
+/// Compressed<X...> -- A tuple for the state of closures.
+///
+/// Elements of empty types take no space, so a closure over stateless
+/// function objects is itself empty, and nested closures are no larger than
+/// what they capture. Copying is trivial if copying each element is, so small
+/// closures are passed in registers.
+template<class...X>
+using Compressed = CompressedImpl<std::index_sequence_for<X...>, X...>;
+
+} // namespace tpl
+} // namespace fu
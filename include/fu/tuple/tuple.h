@@ -125,6 +125,14 @@ constexpr auto ap = multary(ap_f{});
 //constexpr auto ap = zip(invoke);
 
 struct foldl_f {
+#ifdef __cpp_fold_expressions
+  template<class F, class X, class Tuple, class I, I...N>
+  constexpr decltype(auto) operator() (const F& f, X&& acc, Tuple&& t,
+                                       std::integer_sequence<I, N...>) const {
+    return (folded(f, std::forward<X>(acc)) | ... |
+            folded(f, std::get<N>(std::forward<Tuple>(t)))).get();
+  }
+#else
   template<class F, class X, class Tuple, class I, I A>
   constexpr decltype(auto) operator() (const F& f, X&& acc, Tuple&& t,
                                        std::integer_sequence<I, A>) const {
@@ -145,6 +153,7 @@ struct foldl_f {
                    std::forward<Tuple>(t),
                    std::integer_sequence<I, N...>{});
   }
+#endif
 
   /// foldl(f, x, {a,b,c}) = f(f(f(x,a), b), c)
   template<class F, class X, class Tuple>
@@ -164,6 +173,17 @@ struct foldl_f {
 constexpr auto foldl = multary(foldl_f{});
 
 struct foldr_f {
+#ifdef __cpp_fold_expressions
+  // Folding the elements from the right is folding them, reversed, from the
+  // left.
+  template<class F, class X, class Tuple, class I, I...N>
+  constexpr decltype(auto) operator() (const F& f, X&& acc, Tuple&& t,
+                                       std::integer_sequence<I, N...> is) const
+  {
+    return foldl_f{}(f, std::forward<X>(acc), std::forward<Tuple>(t),
+                     iseq::reverse(is));
+  }
+#else
   template<class F, class X, class Tuple, class I, I A>
   constexpr decltype(auto) operator() (const F& f, X&& acc, Tuple&& t,
                                  std::integer_sequence<I, A>) const {
@@ -181,6 +201,7 @@ struct foldr_f {
                           std::integer_sequence<I, N...>{}),
                   std::get<A>(std::forward<Tuple>(t)));
   }
+#endif
 
   /// foldr(f, x, {a,b,c}) = f(f(f(x,c), b), a)
   template<class F, class X, class Tuple>
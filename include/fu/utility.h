@@ -19,7 +19,7 @@ constexpr auto numeric_binary(F f) {
   struct name##_f {                                        \
     template<class X, class Y>                             \
     constexpr auto operator() (X&& x, Y&& y) const         \
-      -> decltype(auto)                                    \
+      -> decltype(std::forward<X>(x) op std::forward<Y>(y))\
     { return std::forward<X>(x) op std::forward<Y>(y); }   \
   };                                                       \
   constexpr auto name = numeric_binary(name##_f{});
@@ -47,6 +47,8 @@ DECL_BIN_OP(and_,     &&);
 DECL_BIN_OP(xor_,     ^);
 DECL_BIN_OP(bit_or,   |);
 DECL_BIN_OP(xor_eq_,  ^=);
+DECL_BIN_OP(bit_or_eq, |=);
+DECL_BIN_OP(bit_and_eq, &=);
 
 // TODO: Why does the macro fail on bit_and?
 //DECl_BIN_OP(bit_and, &,  true);
@@ -131,10 +133,15 @@ constexpr struct post_dec_f {
 } post_dec{};
 
 struct max_f {
-  // FIXME: This should return decltype(auto), but GCC 4.9 deduces that the
-  // call, max(1,2,3) returns a reference to temporary from Part::operator().
-  // Changing Part::args to act like std::forward_as_tuple fixes this, but
-  // makes the expression non-constexpr.
+  /// Lvalues of one type: a reference to the greater, like std::max, so that
+  /// max(a, b, c...) copies nothing.
+  template<class X>
+  constexpr X& operator() (X& x, X& y) const {
+    return x < y ? y : x;
+  }
+
+  /// Otherwise, the greater, moved if it is an rvalue, rather than a
+  /// reference that could outlive it.
   template<class X, class Y>
   constexpr auto operator() (X&& x, Y&& y) const {
     return x < y ? std::forward<Y>(y) : std::forward<X>(x);
@@ -142,6 +149,11 @@ struct max_f {
 };
 
 struct min_f {
+  template<class X>
+  constexpr X& operator() (X& x, X& y) const {
+    return y < x ? y : x;
+  }
+
   template<class X, class Y>
   constexpr auto operator() (X&& x, Y&& y) const {
     return x < y ? std::forward<X>(x) : std::forward<Y>(y);
@@ -151,6 +163,65 @@ struct min_f {
 constexpr auto max = multary(lassoc(max_f{}));
 constexpr auto min = multary(lassoc(min_f{}));
 
+// Helper to declare operators both associative and commutative (as they are
+// for the built-in types).
+#define DECL_ASSOC_COMM(name)                                      \
+  template<> struct Associative<name##_f> : Bool<true> { };       \
+  template<> struct Commutative<name##_f> : Bool<true> { };
+
+DECL_ASSOC_COMM(add);
+DECL_ASSOC_COMM(mult);
+DECL_ASSOC_COMM(or_);
+DECL_ASSOC_COMM(and_);
+DECL_ASSOC_COMM(xor_);
+DECL_ASSOC_COMM(bit_or);
+DECL_ASSOC_COMM(bit_and);
+DECL_ASSOC_COMM(max);
+DECL_ASSOC_COMM(min);
+
+#undef DECL_ASSOC_COMM
+
+/// Updates an accumulator with the compound assignment, `Eq`, when the types
+/// support it, or else as InPlace<F> does by default.
+template<class F, class Eq>
+struct InPlaceAssign {
+  template<class X, class Y>
+  static auto update(Rank<1>, const F&, X& x, Y&& y)
+    -> decltype(void(Eq{}(x, std::forward<Y>(y))))
+  {
+    Eq{}(x, std::forward<Y>(y));
+  }
+
+  template<class X, class Y>
+  static void update(Rank<0>, const F& f, X& x, Y&& y) {
+    InPlace<void>::update(f, x, std::forward<Y>(y));
+  }
+
+  template<class X, class Y>
+  static void update(const F& f, X& x, Y&& y) {
+    update(Rank<1>{}, f, x, std::forward<Y>(y));
+  }
+};
+
+// Helper to map operators to their compound-assignment forms.
+#define DECL_IN_PLACE(name)                                           \
+  template<> struct InPlace<name##_f>                                 \
+    : InPlaceAssign<name##_f, name##_eq_f> { };
+
+DECL_IN_PLACE(add);
+DECL_IN_PLACE(sub);
+DECL_IN_PLACE(mult);
+DECL_IN_PLACE(div);
+DECL_IN_PLACE(rem);
+DECL_IN_PLACE(lshift);
+DECL_IN_PLACE(rshift);
+DECL_IN_PLACE(bit_or);
+DECL_IN_PLACE(bit_and);
+
+template<> struct InPlace<xor__f> : InPlaceAssign<xor__f, xor_eq__f> { };
+
+#undef DECL_IN_PLACE
+
 constexpr struct size_f {
   template<class X, std::size_t N>
   constexpr std::size_t operator() (X (&)[N]) const {
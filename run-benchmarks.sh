@@ -0,0 +1,10 @@
+#!/bin/sh
+
+if [ "$CXX" = "clang++" ]; then export EXTRA="-stdlib=libc++ -I/usr/include/c++/v1"; fi
+
+for file in bench/*.cpp
+do
+  echo "running ${file}..."
+  $CXX $file -std=c++14 -Iinclude -O2 -march=native -pthread $EXTRA -o bench.out || exit 1
+  ./bench.out || exit 1
+done
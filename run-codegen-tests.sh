@@ -0,0 +1,55 @@
+#!/bin/sh
+# Compiles pairs of functions at -O2, fu_NAME, written with fu, and
+# manual_NAME, written by hand, and fails if a fu_ function compiles to more
+# instructions than its counterpart. Pairs named in a "// XFAIL: NAME..."
+# comment are known to cost more, and fail if they stop doing so.
+
+if [ "$CXX" = "clang++" ]; then export EXTRA="-stdlib=libc++ -I/usr/include/c++/v1"; fi
+
+asm=$(mktemp) || exit 1
+trap 'rm -f "$asm"' EXIT
+
+status=0
+for file in test/codegen/*.cpp
+do
+  echo "compiling ${file}..."
+  $CXX $file -std=${STD:-c++14} -Iinclude -O2 -S -fno-asynchronous-unwind-tables \
+       $EXTRA -o "$asm" || exit 1
+
+  xfail=$(sed -n 's|^// XFAIL:||p' $file | tr '\n' ' ')
+  awk -v xfail=" $xfail " '
+    /^[A-Za-z_][A-Za-z0-9_]*:/ {
+      name = substr($1, 1, length($1) - 1)
+      if (name ~ /^fu_/) pairs[++k] = substr(name, 4)
+      next
+    }
+    /^\t\.size\t/ { name = "" }
+    name && /^\t[a-z]/ { n[name]++ }
+    END {
+      for (i = 1; i <= k; i++) {
+        p = pairs[i]
+        if (!(("manual_" p) in n)) {
+          printf "FAIL %s: no manual_%s\n", p, p
+          failed = 1
+          continue
+        }
+        fu = n["fu_" p]
+        manual = n["manual_" p]
+        known = index(xfail, " " p " ") > 0
+        if (fu > manual && !known) {
+          printf "FAIL %s: %d instructions, by hand %d\n", p, fu, manual
+          failed = 1
+        } else if (fu <= manual && known) {
+          printf "FAIL %s: %d instructions, by hand %d; remove its XFAIL\n",
+                 p, fu, manual
+          failed = 1
+        } else {
+          printf "%s %s: %d instructions, by hand %d\n",
+                 known ? "xfail" : "ok", p, fu, manual
+        }
+      }
+      exit failed
+    }' "$asm" || status=1
+done
+
+exit $status
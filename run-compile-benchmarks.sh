@@ -0,0 +1,73 @@
+#!/bin/sh
+# Compiles synthetic workloads that stress fu's templates, measuring each
+# compile's wall time, peak memory and, on clang, template instantiations.
+# Prints the results as JSON. Given the results of an earlier run, also fails
+# if any workload now takes over 10% more time or memory.
+#
+# usage: ./run-compile-benchmarks.sh [baseline.json] > results.json
+
+if [ "$CXX" = "clang++" ]; then
+  export EXTRA="-stdlib=libc++ -I/usr/include/c++/v1"
+  TRACE="-ftime-trace -ftime-trace-granularity=0"
+fi
+
+baseline=$1
+tmp=$(mktemp -d) || exit 1
+trap 'rm -rf "$tmp"' EXIT
+
+$CXX bench/compile/measure.cpp -O2 -o "$tmp/measure" >&2 || exit 1
+
+first=1
+echo "["
+
+bench() {
+  name=$1
+  shift
+  for n in "$@"
+  do
+    echo "compiling bench/compile/${name}.cpp with N=${n}..." >&2
+    rm -f "$tmp/$name.json"
+    result=$("$tmp/measure" $CXX bench/compile/$name.cpp -std=${STD:-c++14} -Iinclude \
+             -DBENCH_N=$n -c -o "$tmp/$name.o" $EXTRA $TRACE) || exit 1
+    set -- $result
+    seconds=$1
+    rss=$2
+
+    # clang writes its trace beside the object file.
+    insts=null
+    if [ -f "$tmp/$name.json" ]; then
+      insts=$(grep -o '"name":"Instantiate[A-Za-z]*"' "$tmp/$name.json" | wc -l)
+      insts=$((insts))
+    fi
+
+    key="\"workload\": \"$name\", \"n\": $n,"
+    [ $first = 1 ] || echo ","
+    first=0
+    printf '  {%s "seconds": %s, "max_rss_kb": %s, "instantiations": %s}' \
+           "$key" "$seconds" "$rss" "$insts"
+
+    if [ -n "$baseline" ]; then
+      old=$(grep -F "$key" "$baseline")
+      [ -n "$old" ] && echo "$old" | awk -v s="$seconds" -v r="$rss" -v w="$name" -v n="$n" '{
+        match($0, /"seconds": [0-9.]+/); s0 = substr($0, RSTART + 11, RLENGTH - 11)
+        match($0, /"max_rss_kb": [0-9]+/); r0 = substr($0, RSTART + 14, RLENGTH - 14)
+        if (s > 1.1 * s0 || r > 1.1 * r0) {
+          printf "REGRESSION: %s N=%s: %.3fs -> %.3fs, %d KiB -> %d KiB\n",
+                 w, n, s0, s, r0, r > "/dev/stderr"
+          exit 1
+        }
+      }' || touch "$tmp/regressed"
+    fi
+  done
+}
+
+bench add 2 16 64 128 256
+bench multary 2 8 16 32
+bench tuple 16 64 128
+bench overload 10 25 50
+bench fold 16 64 128 256
+
+echo
+echo "]"
+
+[ ! -f "$tmp/regressed" ]
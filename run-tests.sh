@@ -2,9 +2,11 @@
 
 if [ "$CXX" = "clang++" ]; then export EXTRA="-stdlib=libc++ -I/usr/include/c++/v1"; fi
 
-for file in test/*
+for file in test/*.cpp
 do
   echo "compiling ${file}..."
-  $CXX $file -std=c++14 -Iinclude -Wall -Wextra -Werror $EXTRA || exit 1
+  $CXX $file -std=${STD:-c++14} -Iinclude -Wall -Wextra -Werror -pthread $EXTRA || exit 1
   ./a.out || exit 1
 done
+
+./run-codegen-tests.sh || exit 1
@@ -0,0 +1,110 @@
+// Pairs of functions, fu_NAME and manual_NAME, of which fu_NAME should compile
+// to no more instructions at -O2. Checked by run-codegen-tests.sh.
+//
+// Functions called through pointers are not inlined through Part.
+// XFAIL: all_fn
+// logic::project's recursion compiles to a branch where && does not.
+// XFAIL: all
+
+#include <fu/fu.h>
+
+#include <algorithm>
+#include <string>
+
+struct P {
+  int x, y;
+};
+
+constexpr struct positive_f {
+  constexpr bool operator() (int x) const { return x > 0; }
+} positive{};
+
+constexpr bool is_positive(int x) { return x > 0; }
+
+extern "C" {
+
+int fu_add(int x) { return fu::add(1)(x); }
+int manual_add(int x) { return x + 1; }
+
+bool fu_proj_less(const P& a, const P& b) {
+  return fu::proj(fu::less, &P::x)(a, b);
+}
+bool manual_proj_less(const P& a, const P& b) { return a.x < b.x; }
+
+bool fu_proj_less_member(const P& a, const P& b) {
+  return fu::proj_less(&P::y)(a, b);
+}
+bool manual_proj_less_member(const P& a, const P& b) { return a.y < b.y; }
+
+int fu_rproj(const P& a, const P& b) {
+  return fu::rproj(fu::sub, &P::y)(a.x, b);
+}
+int manual_rproj(const P& a, const P& b) { return a.x - b.y; }
+
+int fu_rclosure(int x) { return fu::rclosure(fu::sub, 1)(x); }
+int manual_rclosure(int x) { return x - 1; }
+
+int fu_compose_n(int x, int y, int z) {
+  return fu::compose_n<2>(fu::mult, fu::add)(x, y, z);
+}
+int manual_compose_n(int x, int y, int z) { return (x + y) * z; }
+
+int fu_ucompose(int x) {
+  return fu::ucompose(fu::mult(2), fu::add(1))(x);
+}
+int manual_ucompose(int x) { return (x + 1) * 2; }
+
+int fu_pipe(int x) { return fu::pipe(x, fu::add(1), fu::mult(2)); }
+int manual_pipe(int x) { return (x + 1) * 2; }
+
+int fu_flip(int x, int y) { return fu::flip(fu::sub)(x, y); }
+int manual_flip(int x, int y) { return y - x; }
+
+bool fu_all(int x, int y, int z) {
+  return fu::logic::all(positive)(x, y, z);
+}
+bool manual_all(int x, int y, int z) {
+  return positive(x) && positive(y) && positive(z);
+}
+
+bool fu_any(int x, int y, int z) {
+  return fu::logic::any(positive)(x, y, z);
+}
+bool manual_any(int x, int y, int z) {
+  return positive(x) || positive(y) || positive(z);
+}
+
+int fu_max(int x, int y, int z) { return fu::max(x, y, z); }
+int manual_max(int x, int y, int z) { return std::max(std::max(x, y), z); }
+
+// Associative operators on many arguments of one arithmetic type are applied
+// as a balanced tree.
+double fu_add_tree(double a, double b, double c, double d,
+                   double e, double f, double g, double h) {
+  return fu::add(a, b, c, d, e, f, g, h);
+}
+double manual_add_tree(double a, double b, double c, double d,
+                       double e, double f, double g, double h) {
+  return ((a + b) + (c + d)) + ((e + f) + (g + h));
+}
+
+int fu_foldl(int x, int y, int z) {
+  return fu::tpl::foldl(fu::add, x, std::make_tuple(y, z));
+}
+int manual_foldl(int x, int y, int z) { return x + y + z; }
+
+std::size_t fu_max_string(const std::string& a, const std::string& b) {
+  return fu::max(a, b).size();
+}
+std::size_t manual_max_string(const std::string& a, const std::string& b) {
+  return std::max(a, b).size();
+}
+
+bool fu_all_fn(int x, int y, int z) {
+  return fu::logic::all(is_positive)(x, y, z);
+}
+bool manual_all_fn(int x, int y, int z) {
+  return is_positive(x) && is_positive(y) && is_positive(z);
+}
+
+} // extern "C"
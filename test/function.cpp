@@ -0,0 +1,134 @@
+#include <fu/function.h>
+#include <fu/utility.h>
+
+#include <cassert>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+static int allocations = 0;
+
+void* operator new (std::size_t n) {
+  allocations++;
+  if (void* p = std::malloc(n)) return p;
+  throw std::bad_alloc();
+}
+
+void operator delete (void* p) noexcept { std::free(p); }
+void operator delete (void* p, std::size_t) noexcept { std::free(p); }
+
+int add3(int x, int y, int z) { return x + y + z; }
+int add_ints(int x, int y) { return x + y; }
+
+int main() {
+  {
+    // Typical fu partials are stored inline: no allocations.
+    int before = allocations;
+    fu::function<int(int)> inc = fu::add(1);
+    fu::function<int(int, int)> plus = fu::add;
+    fu::function<bool(int)> positive = fu::rpart(fu::greater, 0);
+    fu::function<int(int)> f = fu::part(add3, 1, 2);
+    assert(inc(1) == 2 && plus(2, 3) == 5 && positive(1) && f(3) == 6);
+
+    fu::function<int(int)> moved = std::move(inc);
+    assert(!inc && moved(2) == 3);
+    inc = std::move(moved);
+    assert(inc(3) == 4);
+    assert(allocations == before);
+
+    static_assert(decltype(inc)::is_inline<decltype(fu::add(1))>(), "");
+  }
+
+  {
+    // Move-only function objects.
+    auto p = std::make_unique<int>(5);
+    fu::function<int()> get = [p = std::move(p)] { return *p; };
+    fu::function<int()> other = std::move(get);
+    assert(other() == 5);
+
+    std::vector<fu::function<int(int)>> fs;
+    fs.push_back(fu::add(1));
+    fs.push_back(fu::mult(2));
+    fs.push_back([](int x) { return x * x; });
+    assert(fs[0](3) == 4 && fs[1](3) == 6 && fs[2](3) == 9);
+  }
+
+  {
+    // Large function objects are stored on the heap.
+    struct Big {
+      char data[64];
+      std::size_t operator() () const { return sizeof(data); }
+    };
+    int before = allocations;
+    fu::function<std::size_t()> f = Big{};
+    assert(allocations == before + 1);
+    assert(f() == 64);
+    fu::function<std::size_t()> g = std::move(f);
+    assert(allocations == before + 1 && g() == 64);
+
+    // Unless the inline storage is large enough.
+    fu::function<std::size_t(), 64> h = Big{};
+    assert(allocations == before + 1 && h() == 64);
+  }
+
+  {
+    fu::function<void()> empty;
+    assert(!empty);
+    bool threw = false;
+    try { empty(); } catch (const std::bad_function_call&) { threw = true; }
+    assert(threw);
+
+    int n = 0;
+    fu::function<void()> f = [&] { n++; };
+    f();
+    f = nullptr;
+    assert(n == 1 && !f);
+  }
+
+  {
+    using Ref = fu::function_ref<int(int, int)>;
+    static_assert(sizeof(Ref) == 2 * sizeof(void*), "");
+    static_assert(std::is_trivially_copyable<Ref>{}, "");
+
+    auto apply = [](Ref f, int x, int y) { return f(x, y); };
+
+    int before = allocations;
+    assert(apply(fu::add, 1, 2) == 3);
+    assert(apply(fu::flip(fu::sub), 1, 3) == 2);
+    assert(apply(add_ints, 2, 3) == 5);
+    assert(apply(&add_ints, 3, 3) == 6);
+
+    auto sub = fu::sub;
+    Ref r = sub;
+    Ref copy = r;
+    assert(copy(5, 2) == 3);
+
+    // Member functions, through MemFn, and function pointers, through
+    // forwarder_f.
+    struct Counter {
+      int n;
+      int add(int x) { return n += x; }
+    };
+    Counter c{1};
+    fu::MemFn<int (Counter::*)(int)> add_to(&Counter::add);
+    fu::function_ref<int(Counter&, int)> adder = add_to;
+    assert(adder(c, 2) == 3 && c.n == 3);
+
+    fu::forwarder_f<int(*)(int, int)> fwd(add_ints);
+    assert(apply(fwd, 4, 4) == 8);
+
+    // Stateful function objects are referred to, not copied.
+    int calls = 0;
+    auto count = [&](int x, int) { calls++; return x; };
+    apply(count, 0, 0);
+    apply(count, 0, 0);
+    assert(calls == 2);
+
+    // A fu::function may be referred to as well.
+    fu::function<int(int, int)> mult = fu::mult;
+    assert(apply(mult, 4, 5) == 20);
+    assert(allocations == before);
+  }
+}
@@ -1,5 +1,6 @@
 
 #include <cassert>
+#include <string>
 #include "fu/fu.h"
 
 constexpr int add3(int x, int y, int z) {
@@ -22,6 +23,15 @@ constexpr struct unfixed_pow2_f {
   }
 } unfixed_pow2{};
 
+struct Point {
+  int x, y;
+};
+
+struct Scale {
+  int k;
+  constexpr int operator() (int x) const { return k * x; }
+};
+
 constexpr int divide(int x, int y) {
     return x / y;
 }
@@ -43,6 +53,13 @@ int main() {
   static_assert(fu::rassoc(divide, 10,8,8,2) == 10/(8/(8/2)), "");
   static_assert(fu::rassoc(divide)(10,8,8,2) == 10/(8/(8/2)), "");
 
+  static_assert(fu::tree_assoc(fu::sub, 10,2) == 10-2, "");
+  static_assert(fu::tree_assoc(fu::sub, 10,2,1) == 10-(2-1), "");
+  static_assert(fu::tree_assoc(fu::sub, 10,3,2,1) == (10-3)-(2-1), "");
+  static_assert(fu::tree_assoc(fu::sub)(10,3,2,1,1) == (10-3)-(2-(1-1)), "");
+  assert(fu::tree_assoc(fu::add, std::string("a"), "b", std::string("c"), "d")
+         == "abcd");
+
   // FIXME: gcc cannot evaluate some tests as constexpr, although clang can,
   // and it's vice versa for other tests.
 #ifdef __clang__
@@ -90,6 +107,68 @@ int main() {
   GCC_STATIC_ASSERT(pow2(2) == 4);
   GCC_STATIC_ASSERT(pow2(3) == 8);
 
+  {
+    // Tail calls in constant stack space, however deep.
+    auto sum_to = fu::fix_tc([](auto rec, long n, long acc)
+                               -> fu::TailCall<long(long, long)> {
+      if (n == 0) return acc;
+      return rec(n - 1, acc + n);
+    });
+    assert(sum_to(10, 0) == 55);
+    assert(sum_to(10000000, 0) == 50000005000000);
+
+    auto count_a = fu::fix_tc([](auto rec, std::string s, int n)
+                                -> fu::TailCall<int(std::string, int)> {
+      if (s.empty()) return n;
+      int a = s.back() == 'a';
+      s.pop_back();
+      return rec(std::move(s), n + a);
+    }, std::string("banana"), 0);
+    assert(count_a == 3);
+  }
+
   static_assert(fu::rpart(fu::less, 10)(5), "");
   static_assert(fu::rpart(fu::less, 5, 6, 7)(2,3,4), "");
+
+  // Closures take only the space of what they capture, and stateless
+  // functions none, so small closures are passed in registers.
+  static_assert(std::is_empty<decltype(fu::add)>{}, "");
+  static_assert(std::is_empty<decltype(fu::ucompose(fu::sub, fu::flip))>{}, "");
+  static_assert(sizeof(fu::add(1)) == sizeof(int), "");
+  static_assert(sizeof(fu::closure(add3, 1)) == 2 * sizeof(&add3), "");
+  static_assert(sizeof(fu::rclosure(fu::sub, 1l)) == sizeof(long), "");
+  static_assert(sizeof(fu::ucompose(fu::mult(2), fu::add(1))) == 2*sizeof(int),
+                "");
+  static_assert(sizeof(fu::proj_less(&Point::x)) == sizeof(&Point::x), "");
+  static_assert(sizeof(fu::forwarder_f<Scale>(Scale{2})) == sizeof(int), "");
+  static_assert(fu::forwarder_f<Scale>(Scale{2})(3) == 6, "");
+
+  static_assert(std::is_trivially_copyable<decltype(fu::add(1))>{}, "");
+  static_assert(std::is_trivially_copyable<
+                  decltype(fu::ucompose(fu::mult(2), fu::add(1)))>{}, "");
+  static_assert(std::is_trivially_copyable<
+                  decltype(fu::proj_less(&Point::x))>{}, "");
+
+  {
+    // Applying a multary function one argument at a time builds one flat
+    // Part, not a Part within a Part.
+    constexpr auto j = fu::join(fu::add)(half)(Scale{3});
+    using Add = std::decay_t<decltype(fu::add)>;
+    static_assert(std::is_same<std::decay_t<decltype(j)>,
+                               fu::Part<fu::join_f, Add, int(*)(int), Scale>>{},
+                  "");
+    static_assert(j(4, 1) == 2 + 3, "");
+    static_assert(fu::join(fu::add)(half)(Scale{3})(4, 1) ==
+                  fu::join(fu::add, half, Scale{3})(4, 1), "");
+
+    // Temporaries are moved into the next application, not copied.
+    std::string s(100, 'a');
+    auto cat = fu::multary_n<2>([](std::string a, const std::string& b,
+                                   const std::string& c) { return a + b + c; });
+    auto cat_s = cat(std::move(s));
+    const char* data = cat_s.arg<0>().data();
+    auto cat_s_b = std::move(cat_s)(std::string(100, 'b'));
+    assert(cat_s_b.arg<0>().data() == data);
+    assert(cat_s_b("c").size() == 201);
+  }
 }
@@ -0,0 +1,67 @@
+#include <fu/group.h>
+#include <fu/tuple.h>
+
+#include <cassert>
+#include <string>
+#include <tuple>
+#include <vector>
+
+struct Sale {
+  int region;
+  long amount;
+};
+
+int main() {
+  std::vector<Sale> sales;
+  for (int i = 0; i < 1000; i++) sales.push_back(Sale{i % 7, i});
+
+  auto amount = [](long acc, const Sale& s) { return acc + s.amount; };
+
+  auto totals = fu::group_by(&Sale::region, amount, 0l, sales);
+  assert(totals.size() == 7);
+  for (auto& g : totals) {
+    long expect = 0;
+    for (int i = g.first; i < 1000; i += 7) expect += i;
+    assert(g.second == expect);
+  }
+  assert(*totals.find(3) == totals.begin()[3].second);
+  assert(totals.find(7) == nullptr);
+
+  // Groups keep the order their keys were first seen.
+  std::vector<std::string> words = {"b", "a", "b", "c", "a", "b"};
+  auto counts = fu::group_by(fu::identity, [](int n, auto&&) { return n + 1; },
+                             0, words);
+  assert(counts.begin()[0].first == "b" && counts.begin()[0].second == 3);
+  assert(counts.begin()[1].first == "a" && counts.begin()[1].second == 2);
+  assert(counts.begin()[2].first == "c" && counts.begin()[2].second == 1);
+
+  // Several aggregates at once: a tuple of folds.
+  auto sum_max = [](std::tuple<long, long> acc, const Sale& s) {
+    return fu::tpl::ap(std::make_tuple(fu::add, fu::max), acc,
+                       std::make_tuple(s.amount, s.amount));
+  };
+  auto stats = fu::group_by(&Sale::region, sum_max, std::make_tuple(0l, 0l),
+                            sales);
+  assert(std::get<0>(*stats.find(0)) == *totals.find(0));
+  assert(std::get<1>(*stats.find(0)) == 994);
+
+  {
+    // Force several partitions even on a single core.
+    fu::par::concurrency() = 4;
+
+    std::vector<Sale> many;
+    for (int i = 0; i < int(fu::par::min_grain) * 6; i++)
+      many.push_back(Sale{(i * 31) % 5003, i % 10});
+
+    auto seq = fu::group_by(&Sale::region, amount, 0l, many);
+    auto par = fu::par::group_by(&Sale::region, amount, 0l, many);
+    assert(par.size() == seq.size());
+    for (auto& g : seq) assert(*par.find(g.first) == g.second);
+
+    // Each group is folded in order, so `f` need not be associative.
+    auto last = [](int, const Sale& s) { return int(s.amount); };
+    auto lasts = fu::par::group_by(&Sale::region, last, -1, many);
+    for (auto& g : fu::group_by(&Sale::region, last, -1, many))
+      assert(*lasts.find(g.first) == g.second);
+  }
+}
@@ -0,0 +1,73 @@
+
+#include <fu/io.h>
+#include <fu/par.h>
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <vector>
+
+#include <unistd.h>
+
+struct Record {
+  int id;
+  double amount;
+};
+
+int main() {
+  char path[] = "/tmp/fu-io-XXXXXX";
+  int fd = mkstemp(path);
+  assert(fd >= 0);
+
+  std::vector<Record> records(1000);
+  for (int i = 0; i < 1000; i++) records[i] = {i, i * 0.5};
+  auto written = write(fd, records.data(), sizeof(Record) * 1000);
+  written += write(fd, "junk", 4);  // not a whole record; ignored
+  assert(written == sizeof(Record) * 1000 + 4);
+  close(fd);
+
+  {
+    fu::io::mapped_range<const Record> rs(path, true);
+    assert(rs.size() == 1000);
+    assert(rs[999].id == 999);
+
+    auto total = fu::foldl(fu::rproj(fu::add, &Record::amount), 0.0, rs);
+    assert(total == 999 * 1000 / 4.0);
+
+    auto ids = fu::map_into(&Record::id, rs);
+    assert(ids.size() == 1000 && ids.back() == 999);
+
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < 3; i++) n += rs.chunk(i, 3).size();
+    assert(n == 1000);
+
+    auto moved = std::move(rs);
+    assert(rs.empty() && moved.size() == 1000);
+  }
+
+  {
+    // A writable mapping is copy-on-write; the file is unchanged.
+    fu::io::mapped_range<int> xs(path);
+    auto ys = fu::map_into(fu::identity, xs);
+    fu::transform(fu::add(1), xs);
+    assert(xs[0] == ys[0] + 1);
+    assert(fu::par::foldl(fu::add, 0l, xs) ==
+           std::accumulate(ys.begin(), ys.end(), 0l) + long(ys.size()));
+  }
+
+  {
+    fu::io::mapped_range<const int> xs(path);
+    assert(xs[0] == 0);
+  }
+
+  unlink(path);
+
+  bool threw = false;
+  try {
+    fu::io::mapped_range<const int> missing(path);
+  } catch (const std::system_error&) {
+    threw = true;
+  }
+  assert(threw);
+}
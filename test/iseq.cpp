@@ -0,0 +1,60 @@
+#include <type_traits>
+#include <tuple>
+#include <utility>
+
+#include <fu/fu.h>
+
+template<class X, class Y>
+constexpr bool same(X, Y) { return std::is_same<X, Y>::value; }
+
+template<std::size_t...i>
+using Seq = std::index_sequence<i...>;
+
+template<class...X>
+constexpr std::size_t count(const std::tuple<X...>&) { return sizeof...(X); }
+
+template<std::size_t...i>
+constexpr auto wide(Seq<i...>) { return std::make_tuple(int(i)...); }
+
+int main() {
+  using namespace fu::iseq;
+
+  constexpr auto s = Seq<3, 1, 4, 1, 5>{};
+  static_assert(same(take<0>(s), Seq<>{}), "");
+  static_assert(same(take<2>(s), Seq<3, 1>{}), "");
+  static_assert(same(take<5>(s), s), "");
+  static_assert(same(drop<0>(s), s), "");
+  static_assert(same(drop<3>(s), Seq<1, 5>{}), "");
+  static_assert(same(drop<5>(s), Seq<>{}), "");
+  static_assert(same(take<2>(Seq<9>{}, s), Seq<9, 3, 1>{}), "");
+
+  static_assert(same(slice<1, 4>(s), Seq<1, 4, 1>{}), "");
+  static_assert(same(slice<2, 2>(s), Seq<>{}), "");
+
+  static_assert(same(reverse(s), Seq<5, 1, 4, 1, 3>{}), "");
+  static_assert(same(reverse(Seq<>{}), Seq<>{}), "");
+
+  static_assert(same(concat(s), s), "");
+  static_assert(same(concat(Seq<1>{}, Seq<>{}, Seq<2, 3>{}), Seq<1, 2, 3>{}),
+                "");
+
+  static_assert(same(push(Seq<1>{}, Integer<std::size_t, 2>{}), Seq<1, 2>{}),
+                "");
+
+  // Other integer types work as well.
+  using Ints = std::integer_sequence<int, -1, 0, 1>;
+  static_assert(same(reverse(Ints{}), std::integer_sequence<int, 1, 0, -1>{}),
+                "");
+
+  // Depth does not grow with the length.
+  constexpr auto big = std::make_index_sequence<1000>{};
+  static_assert(same(drop<1>(big), slice<1, 1000>(big)), "");
+  static_assert(same(reverse(reverse(big)), big), "");
+  static_assert(same(concat(take<500>(big), drop<500>(big)), big), "");
+
+  // Wide tuples.
+  constexpr auto t = wide(std::make_index_sequence<128>{});
+  static_assert(count(fu::tpl::init(t)) == 127, "");
+  static_assert(std::get<0>(fu::tpl::tail(t)) == 1, "");
+  static_assert(std::get<0>(fu::tpl::rrot(t)) == 127, "");
+}
@@ -0,0 +1,221 @@
+
+#include <fu/list.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <list>
+#include <numeric>
+#include <string>
+#include <vector>
+
+/// An accumulator that counts its copies.
+struct Counted {
+  static int copies;
+  int n = 0;
+
+  Counted() = default;
+  Counted(const Counted& o) : n(o.n) { copies++; }
+  Counted(Counted&&) = default;
+  Counted& operator= (const Counted& o) { n = o.n; copies++; return *this; }
+  Counted& operator= (Counted&&) = default;
+
+  Counted& operator+= (int x) { n += x; return *this; }
+  friend Counted operator+ (Counted c, int x) { c += x; return c; }
+};
+
+int Counted::copies = 0;
+
+/// A user function object that customizes its in-place form.
+struct append_f {
+  std::vector<int> operator() (std::vector<int> xs, int x) const {
+    xs.push_back(x);
+    return xs;
+  }
+};
+
+namespace fu {
+  template<>
+  struct InPlace<append_f> {
+    static void update(const append_f&, std::vector<int>& xs, int x) {
+      xs.push_back(x);
+    }
+  };
+}
+
+template<class T, class F>
+void test_transform(const F& f) {
+  // An odd size exercises both the vector and scalar loops.
+  std::vector<T> xs(67), ys;
+  std::iota(std::begin(xs), std::end(xs), T(1));
+  ys = xs;
+
+  fu::transform(f, xs);
+  for (auto& y : ys) y = f(y);
+  assert(xs == ys);
+}
+
+int main() {
+  using Op = fu::Undecorated_t<decltype(fu::add)>;
+  static_assert(std::is_same<Op, fu::add_f>::value, "");
+  static_assert(fu::simd::Supported<fu::add_f, int, int>::value, "");
+  static_assert(fu::simd::Supported<fu::add_f, long, int>::value, "");
+  static_assert(!fu::simd::Supported<fu::add_f, float, double>::value, "");
+  static_assert(!fu::simd::Supported<fu::add_f, int, void>::value, "");
+
+  test_transform<int>(fu::add(5));
+  test_transform<int>(fu::sub(5));
+  test_transform<int>(fu::mult(3));
+  test_transform<int>(fu::bit_and(0x5a));
+  test_transform<long>(fu::add(5));
+  test_transform<long>(fu::xor_(5l));
+  test_transform<long>(fu::mult(3));
+  test_transform<unsigned>(fu::bit_or(8u));
+  test_transform<float>(fu::mult(0.5f));
+  test_transform<double>(fu::div(1.0));
+  test_transform<float>(fu::add(0.25));  // computes in double
+
+  {
+    int xs[5] = {0,1,2,3,4};
+    fu::transform(fu::add(1), xs);
+    assert(xs[0] == 1 && xs[4] == 5);
+
+    std::list<int> ys = {0,1,2};
+    fu::transform(fu::add(1), ys);
+    assert(ys.back() == 3);
+  }
+
+  {
+    std::vector<int> xs = {1,2,3,4};
+    assert(fu::foldl(fu::add, 0, xs) == 10);
+    assert(fu::foldl(fu::add, 0)(xs) == 10);
+    assert(fu::foldl(fu::max, 0, xs) == 4);
+
+    // The accumulator is never copied.
+    assert(fu::foldl(fu::add, Counted{}, xs).n == 10);
+    auto plus = [](Counted c, int x) { return std::move(c) + x; };
+    assert(fu::foldl(plus, Counted{}, xs).n == 10);
+    assert(Counted::copies == 0);
+
+    assert(fu::foldl(append_f{}, std::vector<int>{}, xs) == xs);
+  }
+
+  {
+    std::vector<int> xs = {1,2,3};
+    std::vector<double> halves = fu::map_into(fu::rpart(fu::div, 2.0), xs);
+    assert(halves == (std::vector<double>{0.5, 1.0, 1.5}));
+
+    // Writing into the same buffer again does not reallocate.
+    const double* data = halves.data();
+    fu::map_into(fu::mult(0.25), xs, halves);
+    assert(halves.data() == data && halves.back() == 0.75);
+
+    std::array<int, 3> ys = {{1,2,3}};
+    std::array<double, 3> hs = fu::map_into(fu::rpart(fu::div, 2.0), ys);
+    assert(hs[0] == 0.5 && hs[2] == 1.5);
+
+    std::list<int> zs = {1,2,3};
+    std::vector<long> longs = fu::map_into(fu::add(1l))(zs);
+    assert(longs.size() == 3 && longs.back() == 4);
+  }
+
+  {
+    using namespace fu::view;
+    std::vector<int> xs = {1,2,3,4,5,6,7,8};
+    auto even = [](int x) { return x % 2 == 0; };
+
+    auto sum_even_squares = map(fu::mult(2)) | filter(even) | take(3)
+                          | fu::foldl(fu::add, 0);
+    assert(sum_even_squares(xs) == 2 + 4 + 6);
+
+    auto evens = xs | filter(even);
+    assert(fu::foldl(fu::add, 0, evens) == 2 + 4 + 6 + 8);
+    assert(fu::foldl(fu::add, 0, evens | map(fu::add(1)) | take(2)) == 3 + 5);
+    assert(fu::foldl(fu::add, 0, take(0, xs)) == 0);
+    assert(fu::foldl(fu::add, 0, take(20, xs)) == 36);
+
+    // take never looks past the n'th element.
+    int looked = 0;
+    auto look = [&](int x) { looked++; return x; };
+    fu::foldl(fu::add, 0, xs | map(look) | take(2));
+    assert(looked == 2);
+
+    int tested = 0;
+    auto test = [&](int x) { tested++; return even(x); };
+    fu::foldl(fu::add, 0, xs | filter(test) | take(1));
+    assert(tested == 2);
+
+    // Rvalue ranges are owned by the view.
+    auto owned = std::vector<int>{1,2,3} | map(fu::mult(10));
+    assert(fu::pipe(owned, fu::foldl(fu::add, 0)) == 60);
+  }
+  {
+    // Compensated summation loses none of what naive summation does.
+    std::vector<double> tenths(1000000, 0.1);
+    double naive = fu::foldl(fu::add, 0.0, tenths);
+    double sum = fu::foldl(fu::compensated_add, 0.0, tenths);
+    assert(std::abs(sum - 100000.0) < std::abs(naive - 100000.0));
+    assert(std::abs(sum - 100000.0) < 1e-9);
+
+    std::list<float> fs = {1e8f, 1.0f, -1e8f, 1.0f};
+    assert(fu::foldl(fu::compensated_add, 0.0f, fs) == 2.0f);
+    assert(fu::foldl(fu::compensated_add, 3.0, std::vector<double>{}) == 3.0);
+  }
+  {
+    std::vector<int> xs = {1,2,3,4,5,6,7,8,9};
+    assert(fu::scanl1(fu::add, xs) ==
+           (std::vector<int>{1,3,6,10,15,21,28,36,45}));
+
+    std::vector<long> ys = {1,2,3,4,5};
+    assert(fu::scanl(fu::add, 10l, ys) == (std::vector<long>{10,11,13,16,20}));
+
+    int zs[] = {1,2,4,8,16};
+    fu::scanl(fu::bit_or, 0, zs);
+    assert(zs[0] == 0 && zs[1] == 1 && zs[2] == 3 && zs[4] == 15);
+
+    std::list<int> ls = {3,1,4,1,5};
+    assert(fu::scanl1(fu::max, ls) == (std::list<int>{3,3,4,4,5}));
+
+    std::vector<int> rs = {1,2,3};
+    assert(fu::scanr1(fu::sub, rs) == (std::vector<int>{2,-1,3}));
+    rs = {1,2,3};
+    assert(fu::scanr(fu::sub, 0, rs) == (std::vector<int>{-1,3,0}));
+
+    // Vectorized and scalar scans agree, including the tails.
+    for (std::size_t n : {0, 1, 3, 4, 5, 17}) {
+      std::vector<std::int64_t> vs(n), ws;
+      std::iota(std::begin(vs), std::end(vs), 1);
+      ws = vs;
+      fu::scanl(fu::add, 5, vs);
+      fu::scan_f::exclusive(fu::Rank<0>{}, fu::add, 5, ws.begin(), ws.end());
+      assert(vs == ws);
+
+      std::vector<std::string> empty(n);
+      fu::scanl1(fu::add, empty);
+    }
+  }
+  {
+    // The projection is called once per element.
+    int calls = 0;
+    auto neg = [&](int x) { calls++; return -x; };
+
+    std::vector<int> xs(1000);
+    std::iota(std::begin(xs), std::end(xs), 0);
+    fu::sort_by(neg, xs);
+    assert(calls == 1000);
+    assert(xs.front() == 999 && xs.back() == 0);
+    assert(std::is_sorted(std::begin(xs), std::end(xs), fu::proj_less(neg)));
+
+    // Ties keep their order.
+    std::vector<std::pair<int, std::string>> ps =
+      {{2, "a"}, {1, "b"}, {2, "c"}, {1, "d"}, {0, "e"}, {2, "f"}};
+    fu::stable_sort_by(&std::pair<int, std::string>::first, ps);
+    std::string order;
+    for (auto& p : ps) order += p.second;
+    assert(order == "ebdacf");
+
+    std::vector<std::string> empty;
+    fu::sort_by(fu::size, empty);
+  }
+}
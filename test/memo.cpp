@@ -0,0 +1,74 @@
+#include <fu/memo.h>
+
+#include <cassert>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main() {
+  {
+    int calls = 0;
+    auto square = fu::memo([&](int x) { calls++; return x * x; }, 64);
+
+    assert(square(3) == 9 && square(3) == 9 && square(4) == 16);
+    assert(calls == 2);
+    assert(square.hits() == 1 && square.misses() == 2);
+
+    // Copies share the cache.
+    auto copy = square;
+    assert(copy(4) == 16 && calls == 2);
+  }
+
+  {
+    // Arguments are hashed together.
+    int calls = 0;
+    auto cat = fu::memo([&](const std::string& s, int n) {
+      calls++;
+      std::string r;
+      while (n--) r += s;
+      return r;
+    })(16);
+    std::string ab = "ab";
+    assert(cat(ab, 2) == "abab" && cat(std::string("ab"), 2) == "abab");
+    assert(cat(ab, 3) == "ababab");
+    assert(calls == 2);
+  }
+
+  {
+    // The least recently used results are evicted.
+    int calls = 0;
+    auto inc = fu::memo([&](int x) { calls++; return x + 1; }, 16);
+    for (int i = 0; i < 1000; i++) inc(i);
+    assert(calls == 1000);
+    inc(999);
+    assert(calls == 1000);
+    inc(0);
+    assert(calls == 1001);
+  }
+
+  {
+    // Recursive calls are memoized, so this takes linear time.
+    int calls = 0;
+    auto fib = fu::memo_fix([&](const auto& rec, long n) -> long {
+      calls++;
+      return n < 2 ? n : rec(n-1) + rec(n-2);
+    }, 256);
+    assert(fib(80) == 23416728348467685);
+    assert(calls == 81);
+  }
+
+  {
+    // Threads may share a memoized function.
+    auto square = fu::memo([](long x) { return x * x; }, 1024);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+      threads.emplace_back([&] {
+        for (long i = 0; i < 10000; i++)
+          assert(square(i % 100) == (i % 100) * (i % 100));
+      });
+    }
+    for (auto& t : threads) t.join();
+    assert(square.hits() + square.misses() == 40000);
+    assert(square.misses() >= 100);
+  }
+}
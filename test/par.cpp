@@ -0,0 +1,114 @@
+
+#include <fu/par.h>
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+#include <string>
+#include <vector>
+
+int main() {
+  static_assert(fu::Associative<std::decay_t<decltype(fu::add)>>::value, "");
+  static_assert(fu::Associative<std::decay_t<decltype(fu::max)>>::value, "");
+  static_assert(!fu::Associative<std::decay_t<decltype(fu::sub)>>::value, "");
+  static_assert(fu::Commutative<std::decay_t<decltype(fu::mult)>>::value, "");
+
+  // Force several chunks even on a single core.
+  fu::par::concurrency() = 4;
+
+  std::vector<long> xs(fu::par::min_grain * 8 + 3);
+  std::iota(std::begin(xs), std::end(xs), 0);
+
+  assert(fu::par::foldl(fu::add, 10l, xs) == fu::foldl(fu::add, 10l, xs));
+  assert(fu::par::foldl(fu::max)(-1l, xs) == long(xs.size() - 1));
+  assert(fu::par::foldl(fu::bit_or, 0l, xs) == fu::foldl(fu::bit_or, 0l, xs));
+
+  {
+    std::vector<int> ys(100000, 1);
+    fu::par::transform(fu::add(1), ys);
+    assert(fu::foldl(fu::add, 0, ys) == 200000);
+
+    // Uneven costs still cover every element exactly once.
+    std::vector<int> zs(1000);
+    std::iota(std::begin(zs), std::end(zs), 0);
+    fu::par::transform([](int x) {
+      volatile int spin = x % 7 ? 0 : 100000;
+      while (spin) spin = spin - 1;
+      return x * 2;
+    }, zs);
+    for (int i = 0; i < 1000; i++) assert(zs[i] == 2 * i);
+
+#ifdef __clang__
+    fu::par::transform(fu::add(1))(ys);
+    assert(ys.front() == 3);
+#endif
+  }
+
+  {
+    // Compensated sums are identical regardless of the number of threads.
+    std::vector<double> ds(fu::par::min_grain * 5 + 17);
+    for (std::size_t i = 0; i < ds.size(); i++)
+      ds[i] = (i % 3 ? 1e-3 : 1e5) * (i % 2 ? -1.0 : 1.1);
+
+    double seq = fu::foldl(fu::compensated_add, 0.5, ds);
+    for (std::size_t k : {1, 3, 4}) {
+      fu::par::concurrency() = k;
+      assert(fu::par::foldl(fu::compensated_add, 0.5, ds) == seq);
+    }
+    fu::par::concurrency() = 4;
+  }
+
+  {
+    std::vector<long> offsets(xs.size()), seq;
+    std::iota(std::begin(offsets), std::end(offsets), 0);
+    seq = offsets;
+    fu::scanl(fu::add, 7l, seq);
+    assert(fu::par::scanl(fu::add, 7l, offsets) == seq);
+
+    std::vector<int> counts(fu::par::min_grain * 3 + 5, 1);
+    fu::par::scanl1(fu::add, counts);
+    for (std::size_t i = 0; i < counts.size(); i++) assert(counts[i] == int(i+1));
+
+    std::vector<long> rs(xs.size(), 1), rseq;
+    rs[0] = 0;
+    rseq = rs;
+    fu::scanr1(fu::max, rseq);
+    assert(fu::par::scanr1(fu::max, rs) == rseq);
+    fu::scanr(fu::add, 1l, rseq);
+    assert(fu::par::scanr(fu::add, 1l, rs) == rseq);
+
+    // Associative, but not commutative: chunk order is preserved.
+    std::vector<std::string> strs(fu::par::min_grain * 4, "a");
+    strs[0] = "<";
+    fu::par::scanl1(fu::add, strs);
+    assert(strs.back().size() == strs.size() && strs.back()[0] == '<');
+  }
+
+  {
+    std::vector<long> keys(fu::par::min_grain * 5 + 11);
+    for (std::size_t i = 0; i < keys.size(); i++) keys[i] = (i * 7919) % 1013;
+    auto ys = keys, zs = keys;
+
+    fu::stable_sort_by(fu::identity, ys);
+    assert(fu::par::stable_sort_by(fu::identity, zs) == ys);
+    fu::par::sort_by(fu::sub(0), zs);
+    assert(std::is_sorted(std::rbegin(zs), std::rend(zs)));
+
+    // Ties keep their order.
+    std::vector<std::pair<long, std::size_t>> ps;
+    for (std::size_t i = 0; i < keys.size(); i++) ps.emplace_back(keys[i], i);
+    fu::par::stable_sort_by(&std::pair<long, std::size_t>::first, ps);
+    for (std::size_t i = 1; i < ps.size(); i++)
+      assert(ps[i-1].first < ps[i].first || ps[i-1].second < ps[i].second);
+  }
+
+  // Not associative: folds sequentially.
+  assert(fu::par::foldl(fu::sub, 0l, xs) == fu::foldl(fu::sub, 0l, xs));
+
+  // Associative, but not commutative: chunk order is preserved.
+  std::vector<std::string> strs(fu::par::min_grain * 4, "a");
+  strs.back() = "z";
+  std::string s = fu::par::foldl(fu::add, std::string("<"), strs);
+  assert(s.size() == strs.size() + 1);
+  assert(s.front() == '<' && s.back() == 'z');
+}
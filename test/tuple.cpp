@@ -1,6 +1,8 @@
 
 #include <iostream>
 #include <array>
+#include <cassert>
+#include <memory>
 
 #include <fu/fu.h>
 
@@ -18,6 +20,16 @@ constexpr struct Add {
   }
 } add{};
 
+/// Counts its copies and moves.
+struct Counted {
+  static int copies;
+  Counted() = default;
+  Counted(const Counted&) { copies++; }
+  Counted(Counted&&) { copies++; }
+};
+
+int Counted::copies = 0;
+
 struct Int {
   int x;
   constexpr Int(int x) : x(x) { }
@@ -43,6 +55,28 @@ int main() {
 
   static_assert(apply(add, t2) == 7.0, "");
   static_assert(apply(add)(t2) == 7.0, "");
+  static_assert(apply(fu::add, tuple(1), tuple(), tuple(2, 3)) == 6, "");
+  static_assert(apply(fu::add, std::array<int, 2>{{1, 2}}, tuple(3)) == 6, "");
+
+  {
+    // Elements are forwarded from their tuples, not copied or moved.
+    auto big = tuple(Counted{}, Counted{});
+    Counted::copies = 0;
+    auto count = [](const Counted&, const Counted&, Counted&&, int x) {
+      return x;
+    };
+    assert(apply(count, big, std::forward_as_tuple(Counted{}, 1)) == 1);
+    assert(Counted::copies == 0);
+
+    auto p = fu::closure(count, Counted{});
+    Counted::copies = 0;
+    assert(p(Counted{}, Counted{}, 2) == 2);
+    assert(Counted::copies == 0);
+
+    auto uniq = tuple(std::make_unique<int>(3));
+    auto deref = [](std::unique_ptr<int> p, int x) { return *p + x; };
+    assert(apply(deref, std::move(uniq), tuple(1)) == 4);
+  }
   static_assert(foldl(add, 0, t2) == 7.0, "");
 
   // TODO: Pull in the GCC_ and CLANG_STATIC_ASSERTs from
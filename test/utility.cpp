@@ -1,7 +1,25 @@
 
 #include <fu/fu.h>
 
+#include <cassert>
 #include <list>
+#include <string>
+
+/// Counts its copies.
+struct Counted {
+  static int copies;
+  int x;
+
+  Counted(int x) : x(x) { }
+  Counted(const Counted& c) : x(c.x) { ++copies; }
+  Counted(Counted&&) = default;
+  Counted& operator= (const Counted& c) { x = c.x; ++copies; return *this; }
+  Counted& operator= (Counted&&) = default;
+
+  bool operator< (const Counted& c) const { return x < c.x; }
+};
+
+int Counted::copies = 0;
 
 int main() {
   static_assert(fu::add(1)(2) == 3, "");
@@ -26,6 +44,38 @@ int main() {
   static_assert(fu::max(0,4,2) == 4, "");
   static_assert(fu::min(0,4,2) == 0, "");
 
+  {
+    // Associative operators apply many arguments of one arithmetic type as a
+    // balanced tree, others from left to right.
+    static_assert(fu::add(1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17) == 153, "");
+    static_assert(fu::max(3,1,4,1,5,9,2,6,5,3,5) == 9, "");
+    static_assert(fu::sub(100,1,2,3,4,5) == 85, "");
+    assert(fu::add(0.5, 0.25, 0.125, 0.0625, 1.0) == 1.9375);
+    assert(fu::add(std::string("a"), "b", "c") == "abc");
+  }
+
+  {
+    // max and min of lvalues return references to them, of rvalues move them,
+    // and copy nothing, whichever the compiler.
+    Counted a = 1, b = 3, c = 2;
+    const Counted& greatest = fu::max(a, b, c);
+    const Counted& least = fu::min(a, b, c);
+    assert(&greatest == &b);
+    assert(&least == &a);
+    assert(fu::max(Counted(1), Counted(3), Counted(2)).x == 3);
+    assert(fu::min(Counted(1), b, Counted(2)).x == 1);
+    assert(fu::max(std::ref(b))(a).x == 3);
+    assert(Counted::copies == 0);
+
+    // Partial applications return what the function does.
+    static_assert(std::is_same<decltype(fu::max(a, b)), Counted&>{}, "");
+    static_assert(std::is_same<decltype(fu::closure(fu::max, std::ref(b))(a)),
+                               Counted&>{}, "");
+    static_assert(std::is_same<decltype(fu::rclosure(fu::max, std::ref(b))(a)),
+                               Counted&>{}, "");
+    static_assert(std::is_same<decltype(fu::max(Counted(1), b)), Counted>{}, "");
+  }
+
   {
     constexpr int xs[3] = {0,1,2};
     static_assert(fu::size(xs) == 3, "");